@@ -9,7 +9,9 @@ print_red() {
 }
 
 cd src
-gcc main.c termify/draw.c termify/log.c termify/page_loader.c termify/terminal.c termify/utils.c interstellar-pong-implementation/interstellar_pong.c interstellar-pong-implementation/interstellar_pong_pages.c interstellar-pong-implementation/player.c interstellar-pong-implementation/materials.c interstellar-pong-implementation/levels.c -o ../InterStellar-Pong.app -trigraphs
+gcc main.c termify/byte_buffer.c termify/clock.c termify/draw.c termify/event_loop.c termify/frame.c termify/input.c termify/log.c termify/page_loader.c termify/random.c termify/terminal.c termify/thread_pool.c termify/utils.c interstellar-pong-implementation/ai.c interstellar-pong-implementation/game_data.c interstellar-pong-implementation/headless.c interstellar-pong-implementation/interstellar_pong.c interstellar-pong-implementation/interstellar_pong_pages.c interstellar-pong-implementation/player.c interstellar-pong-implementation/replay.c interstellar-pong-implementation/snapshot.c interstellar-pong-implementation/materials.c interstellar-pong-implementation/levels.c -o ../InterStellar-Pong.app -trigraphs -pthread
+gcc benchmarks/render_benchmark.c termify/byte_buffer.c termify/draw.c termify/frame.c termify/log.c termify/utils.c -o ../Render-Benchmark.app -trigraphs -pthread
+gcc benchmarks/meteor_benchmark.c termify/byte_buffer.c termify/clock.c termify/draw.c termify/frame.c termify/log.c termify/random.c termify/utils.c interstellar-pong-implementation/ai.c interstellar-pong-implementation/game_data.c interstellar-pong-implementation/interstellar_pong.c interstellar-pong-implementation/player.c interstellar-pong-implementation/replay.c interstellar-pong-implementation/materials.c interstellar-pong-implementation/levels.c -o ../Meteor-Benchmark.app -trigraphs -pthread
 cd ..
 
 if [ ! -d "src/termify/temp" ]; then
@@ -20,6 +22,9 @@ if [ ! -d "logs" ]; then
      mkdir "logs"
 fi
 
+# the game loads the compiled image of its data instead of parsing the data file
+./InterStellar-Pong.app --compile-data > /dev/null
+
 if [ $? -eq 0 ]; then
   print_green "Build successful."
 else
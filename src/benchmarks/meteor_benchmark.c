@@ -0,0 +1,310 @@
+/**
+ * @file meteor_benchmark.c
+ * @author Marek Eibel
+ * @brief Benchmark and statistical check of the meteor generator of InterStellar Pong.
+ *
+ * For every level of the game data (`res/game_data.ispdata`), the benchmark respawns a meteor of a game
+ * the given number of times and measures how many meteors are generated per second. The generated meteors
+ * are then compared with the probabilities of the game data by chi-square tests: the materials of every
+ * level and the shapes of every material (1x1, 2x1, 1x2 and 2x2, the materials of all levels together).
+ * The benchmark fails if any test rejects the configured distribution at the significance level of 0.001,
+ * if an outcome with zero probability or a meteor of an unknown material is generated, or if the percents
+ * of a row of the game data do not sum to 100 (the row is not tested then, the generator would bend it). The game is seeded by a fixed seed by default,
+ * so the result of a run can be reproduced.
+ *
+ * Usage: Meteor-Benchmark.app [meteors per level] [seed] (run from the root of the repository).
+ *
+ * @version 0.1
+ * @date 2023-10-08
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "../interstellar-pong-implementation/interstellar_pong.h"
+#include "../interstellar-pong-implementation/paths.h"
+
+// ---------------------------------------- MACROS --------------------------------------------- //
+
+#define GAME_WIDTH 80
+#define GAME_HEIGHT 22
+#define DEFAULT_METEORS_PER_LEVEL 1000000
+#define DEFAULT_SEED 42
+#define MAX_CATEGORIES 10
+#define SIZES_COUNT 2
+#define SHAPES_COUNT 2
+
+/**
+ * @brief Meteor geometries distinguished by the tests.
+ */
+typedef enum meteor_geometry_t {
+    GEOMETRY_1X1,         /** Small square meteor. */
+    GEOMETRY_2X1,         /** Small meteor stretched horizontally. */
+    GEOMETRY_1X2,         /** Small meteor stretched vertically. */
+    GEOMETRY_2X2,         /** Big square meteor. */
+    GEOMETRIES_COUNT      /** Number of the geometries. */
+} meteor_geometry_t;
+
+// ------------------------------------ GLOBAL VARIABLE----------------------------------------- //
+
+/**
+ * @brief Critical values of the chi-square distribution at the significance level of 0.001 indexed by the degrees of freedom.
+ */
+static const double gl_critical_values[MAX_CATEGORIES] = { 0.0, 10.828, 13.816, 16.266, 18.467, 20.515, 22.458, 24.322, 26.124, 27.877 };
+
+static const char *gl_material_names[MATERIALS_COUNT] = { "stone", "copper", "iron", "gold" };
+
+// ---------------------------------- STATIC DECLARATIONS--------------------------------------- //
+
+static bool test_distribution(const char *name, const long *observed, const double *probabilities, int count, long total);
+static bool compute_expected_probabilities(const char *name, const int *percents, int count, double *probabilities);
+static bool compute_expected_geometries(const char *name, const material_row_t *material, double *probabilities);
+static int get_material_index(colour_t colour);
+static meteor_geometry_t get_meteor_geometry(scene_t *scene, ID_t meteor);
+static double get_elapsed_seconds(struct timespec *start, struct timespec *end);
+
+// ----------------------------------------- PROGRAM-------------------------------------------- //
+
+int main(int argc, char **argv)
+{
+    long meteors_per_level = (argc > 1) ? atol(argv[1]) : DEFAULT_METEORS_PER_LEVEL;
+    uint64_t seed = (argc > 2) ? strtoull(argv[2], NULL, 10) : DEFAULT_SEED;
+    if (meteors_per_level <= 0) {
+        fprintf(stderr, "usage: %s [meteors per level] [seed]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    game_t *game = init_game(NULL, GAME_HEIGHT, GAME_WIDTH, seed);
+    if (game == NULL || init_scene(game) == NULL) {
+        fprintf(stderr, "the game could not be created (is %s reachable?)\n", GAME_DATA_PATH);
+        release_game(game);
+        release_game_data_cache();
+        return EXIT_FAILURE;
+    }
+
+    ID_t meteor = game->actors.meteors[0];
+    long geometries[MATERIALS_COUNT][GEOMETRIES_COUNT] = { { 0 } };
+    long unknown_materials = 0;
+    bool is_passed = true;
+
+    printf("%-8s %14s %12s %10s %10s  %s\n", "level", "meteors/s", "chi-square", "df", "critical", "result");
+
+    for (int level = 0; level < game->game_data->levels_table->count; ++level) {
+        const level_row_t *row = &game->game_data->levels_table->levels[level];
+        const int material_percents[MATERIALS_COUNT] = { row->prob_stone, row->prob_copper, row->prob_iron, row->prob_gold };
+        long materials[MATERIALS_COUNT] = { 0 };
+        long known_materials = 0;
+        double probabilities[MATERIALS_COUNT];
+        char name[32];
+
+        game->player->level = level;
+
+        struct timespec start, end;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+
+        for (long i = 0; i < meteors_per_level; ++i) {
+            respawn_meteor(game, meteor);
+            int material = get_material_index(get_object_colour(game->scene, meteor));
+            if (material == -1) {
+                unknown_materials++;
+                continue;
+            }
+            materials[material]++;
+            known_materials++;
+            geometries[material][get_meteor_geometry(game->scene, meteor)]++;
+        }
+
+        clock_gettime(CLOCK_MONOTONIC, &end);
+
+        snprintf(name, sizeof(name), "%d", level);
+        printf("%-8s %14.0f ", name, meteors_per_level / get_elapsed_seconds(&start, &end));
+        if (compute_expected_probabilities(name, material_percents, MATERIALS_COUNT, probabilities)) {
+            is_passed &= test_distribution(name, materials, probabilities, MATERIALS_COUNT, known_materials);
+        } else {
+            is_passed = false;
+        }
+    }
+
+    if (unknown_materials > 0) {
+        printf("%ld meteors of an unknown material were generated\n", unknown_materials);
+        is_passed = false;
+    }
+
+    printf("\n%-8s %14s %12s %10s %10s  %s\n", "material", "meteors", "chi-square", "df", "critical", "result");
+
+    for (int material = 0; material < MATERIALS_COUNT && material < game->game_data->materials_table->count; ++material) {
+        double probabilities[GEOMETRIES_COUNT];
+        long total = 0;
+
+        for (int i = 0; i < GEOMETRIES_COUNT; ++i) {
+            total += geometries[material][i];
+        }
+
+        printf("%-8s %14ld ", gl_material_names[material], total);
+        if (compute_expected_geometries(gl_material_names[material], &game->game_data->materials_table->materials[material], probabilities)) {
+            is_passed &= test_distribution(gl_material_names[material], geometries[material], probabilities, GEOMETRIES_COUNT, total);
+        } else {
+            is_passed = false;
+        }
+    }
+
+    release_game(game);
+    release_game_data_cache();
+
+    printf("\n%s\n", is_passed ? "the generated meteors follow the game data" : "the generated meteors DRIFT from the game data");
+    return is_passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+ * @brief Runs a chi-square goodness-of-fit test of the observed counts and prints its result.
+ *        The categories with zero probability are left out of the statistic, but any meteor observed in them fails the test.
+ *
+ * @param name The name of the tested distribution (used in the messages).
+ * @param observed The observed counts of the categories.
+ * @param probabilities The expected probabilities of the categories.
+ * @param count The number of the categories (at most MAX_CATEGORIES).
+ * @param total The number of the observations.
+ * @return true if the observed counts are consistent with the probabilities, false otherwise.
+ */
+static bool test_distribution(const char *name, const long *observed, const double *probabilities, int count, long total)
+{
+    double chi_square = 0.0;
+    int categories = 0;
+    bool is_impossible_observed = false;
+
+    for (int i = 0; i < count; ++i) {
+        if (probabilities[i] <= 0.0) {
+            is_impossible_observed |= (observed[i] > 0);
+            continue;
+        }
+
+        double expected = probabilities[i] * total;
+        chi_square += (observed[i] - expected) * (observed[i] - expected) / expected;
+        categories++;
+    }
+
+    int degrees_of_freedom = (categories > 0) ? categories - 1 : 0;
+    double critical_value = gl_critical_values[degrees_of_freedom];
+    bool is_passed = !is_impossible_observed && (total == 0 || chi_square <= critical_value);
+
+    printf("%12.3f %10d %10.3f  %s\n", chi_square, degrees_of_freedom, critical_value, is_passed ? "ok" : "FAILED");
+    if (is_impossible_observed) {
+        printf("         %s: an outcome with zero probability was generated\n", name);
+    }
+
+    return is_passed;
+}
+
+/**
+ * @brief Computes the probabilities of the outcomes from their percents. The percents have to be a distribution:
+ *        each of them in [0, 100] and 100 in total. Other rows are reported as failed instead of being tested,
+ *        because the generator cuts them or fills them up (see `build_percent_table()`), which the game data does not describe.
+ *
+ * @param name The name of the row (used in the messages).
+ * @param percents The probabilities of the outcomes in percent.
+ * @param count The number of the outcomes.
+ * @param probabilities Placeholder for the probabilities of the outcomes.
+ * @return true if the percents are a distribution, false otherwise (the failure is printed).
+ */
+static bool compute_expected_probabilities(const char *name, const int *percents, int count, double *probabilities)
+{
+    int sum = 0;
+    bool is_in_range = true;
+
+    for (int i = 0; i < count; ++i) {
+        is_in_range &= (percents[i] >= 0 && percents[i] <= PERCENT_TABLE_SIZE);
+        sum += percents[i];
+        probabilities[i] = (double)percents[i] / PERCENT_TABLE_SIZE;
+    }
+
+    if (!is_in_range || sum != PERCENT_TABLE_SIZE) {
+        printf("%12s %10s %10s  FAILED\n", "-", "-", "-");
+        printf("         %s: the percents sum to %d instead of %d (or one is out of range), the row is not tested\n",
+               name, sum, PERCENT_TABLE_SIZE);
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Computes the probabilities of the geometries of a meteor of the material. A rectangle is made from
+ *        a small meteor and its sides are swapped with the probability of 50 %, a big meteor stays a square.
+ *
+ * @param name The name of the material (used in the messages).
+ * @param material The material.
+ * @param probabilities Placeholder for the probabilities indexed by meteor_geometry_t.
+ * @return true if the size and shape percents of the material are distributions, false otherwise (the failure is printed).
+ */
+static bool compute_expected_geometries(const char *name, const material_row_t *material, double *probabilities)
+{
+    const int size_percents[SIZES_COUNT] = { material->prob_size_1_px_t, material->prob_size_2_px_t };
+    const int shape_percents[SHAPES_COUNT] = { material->prob_rectangle_shape, material->prob_square_shape };
+    double sizes[SIZES_COUNT], shapes[SHAPES_COUNT];
+
+    if (!compute_expected_probabilities(name, size_percents, SIZES_COUNT, sizes)
+        || !compute_expected_probabilities(name, shape_percents, SHAPES_COUNT, shapes)) {
+        return false;
+    }
+
+    probabilities[GEOMETRY_1X1] = sizes[0] * shapes[SQUARE];
+    probabilities[GEOMETRY_2X1] = sizes[0] * shapes[RECTANGLE] / 2;
+    probabilities[GEOMETRY_1X2] = sizes[0] * shapes[RECTANGLE] / 2;
+    probabilities[GEOMETRY_2X2] = sizes[1];
+
+    return true;
+}
+
+/**
+ * @brief Gets the index of the material of a meteor by its colour (the order of the game data).
+ *
+ * @param colour The colour of the meteor.
+ * @return The index of the material, or -1 if the colour is not a colour of any material.
+ */
+static int get_material_index(colour_t colour)
+{
+    switch ((material_type_t)colour)
+    {
+    case STONE: return 0;
+    case COPPER: return 1;
+    case IRON: return 2;
+    case GOLD: return 3;
+    default: return -1;
+    }
+}
+
+/**
+ * @brief Gets the geometry of a meteor. The game keeps the widths of the objects in terminal cells, two per pixel.
+ *
+ * @param scene The scene of the game.
+ * @param meteor The ID of the meteor.
+ * @return The geometry of the meteor.
+ */
+static meteor_geometry_t get_meteor_geometry(scene_t *scene, ID_t meteor)
+{
+    int index = get_object_index(scene, meteor);
+    int width = scene->widths[index] / 2;
+    int height = scene->heights[index];
+
+    if (width == height) {
+        return (width == 1) ? GEOMETRY_1X1 : GEOMETRY_2X2;
+    }
+
+    return (width > height) ? GEOMETRY_2X1 : GEOMETRY_1X2;
+}
+
+/**
+ * @brief Computes the time elapsed between two time points.
+ *
+ * @param start The earlier time point.
+ * @param end The later time point.
+ * @return The elapsed time in seconds.
+ */
+static double get_elapsed_seconds(struct timespec *start, struct timespec *end)
+{
+    return (end->tv_sec - start->tv_sec) + (end->tv_nsec - start->tv_nsec) / 1e9;
+}
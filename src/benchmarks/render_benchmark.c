@@ -0,0 +1,132 @@
+/**
+ * @file render_benchmark.c
+ * @author Marek Eibel
+ * @brief Benchmark measuring the cost of `render_graphics()` depending on the number of objects in the scene.
+ *
+ * Every measured frame is a full repaint of the game-sized canvas, so every cell has its colour resolved.
+ * Only a few objects are put into the pixel buffer, so the amount of produced output is the same for all
+ * measurements and only the size of the scene changes. The frames are collected in a frame buffer which is
+ * never sent to the terminal. With the palette lookup, the time per frame is expected to stay flat as the
+ * number of objects grows.
+ *
+ * @version 0.1
+ * @date 2023-09-22
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "../termify/draw.h"
+#include "../termify/frame.h"
+
+// ---------------------------------------- MACROS --------------------------------------------- //
+
+#define CANVAS_WIDTH 80
+#define CANVAS_HEIGHT 22
+#define FRAMES_PER_MEASUREMENT 2000
+#define VISIBLE_OBJECTS_COUNT 4
+#define FRAME_BUFFER_CAPACITY 65536
+
+// ---------------------------------- STATIC DECLARATIONS--------------------------------------- //
+
+static double measure_render_cost(int objects_count, frame_buffer_t *frame);
+static double get_elapsed_nanoseconds(struct timespec *start, struct timespec *end);
+
+// ----------------------------------------- PROGRAM-------------------------------------------- //
+
+int main(void)
+{
+    const int OBJECTS_COUNTS[] = { 4, 16, 128, 1024, 8192, 65000 };
+    const int MEASUREMENTS_COUNT = sizeof(OBJECTS_COUNTS) / sizeof(OBJECTS_COUNTS[0]);
+
+    frame_buffer_t *frame = create_frame_buffer(FRAME_BUFFER_CAPACITY);
+    if (frame == NULL) {
+        return EXIT_FAILURE;
+    }
+
+    srand(42);
+    printf("%-10s %18s\n", "objects", "ns per frame");
+
+    for (int i = 0; i < MEASUREMENTS_COUNT; ++i) {
+        double cost = measure_render_cost(OBJECTS_COUNTS[i], frame);
+        if (cost < 0) {
+            release_frame_buffer(frame);
+            return EXIT_FAILURE;
+        }
+        printf("%-10d %18.0f\n", OBJECTS_COUNTS[i], cost);
+    }
+
+    release_frame_buffer(frame);
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Creates a scene with <objects_count> small objects and measures the average time of rendering one frame.
+ *
+ * @param objects_count The number of objects in the scene.
+ * @param frame The frame buffer collecting the rendered output.
+ * @return The average time of one frame in nanoseconds, or -1 on failure.
+ */
+static double measure_render_cost(int objects_count, frame_buffer_t *frame)
+{
+    scene_t *scene = create_scene();
+    pixel_buffer_t *pixel_buffer = create_pixel_buffer(CANVAS_HEIGHT, CANVAS_WIDTH);
+    render_state_t *render_state = create_render_state(CANVAS_HEIGHT, CANVAS_WIDTH);
+
+    if (scene == NULL || pixel_buffer == NULL || render_state == NULL) {
+        release_scene(scene);
+        release_pixel_buffer(pixel_buffer);
+        release_render_state(render_state);
+        return -1;
+    }
+
+    for (int i = 0; i < objects_count; ++i) {
+        rectangle_t object = create_rectangle(rand() % (CANVAS_WIDTH - 2), rand() % CANVAS_HEIGHT, 1, 1, 0, 0, (colour_t)(1 + i % LIGHT_CYAN), "object");
+        ID_t ID = add_to_scene(scene, &object);
+        if (ID == UNDEFINIED_ID) {
+            release_scene(scene);
+            release_pixel_buffer(pixel_buffer);
+            release_render_state(render_state);
+            return -1;
+        }
+        if (i < VISIBLE_OBJECTS_COUNT) {
+            (void)compute_object_pixels_in_buffer(pixel_buffer, scene, ID, NULL);
+        }
+    }
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for (int i = 0; i < FRAMES_PER_MEASUREMENT; ++i) {
+        begin_frame(frame);
+        invalidate_render_state(render_state);
+        render_graphics(pixel_buffer, scene, render_state);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    // nothing of the measured output is sent to the terminal
+    clear_frame_buffer(frame);
+    (void)end_frame();
+
+    release_scene(scene);
+    release_pixel_buffer(pixel_buffer);
+    release_render_state(render_state);
+
+    return get_elapsed_nanoseconds(&start, &end) / FRAMES_PER_MEASUREMENT;
+}
+
+/**
+ * @brief Computes the time elapsed between two time points.
+ *
+ * @param start The earlier time point.
+ * @param end The later time point.
+ * @return The elapsed time in nanoseconds.
+ */
+static double get_elapsed_nanoseconds(struct timespec *start, struct timespec *end)
+{
+    return (end->tv_sec - start->tv_sec) * 1e9 + (end->tv_nsec - start->tv_nsec);
+}
@@ -0,0 +1,192 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "ai.h"
+
+// ---------------------------------------- MACROS --------------------------------------------- //
+
+#define AI_NO_TARGET -1
+
+/**
+ * @struct ai_difficulty_settings_t
+ * @brief Describes how the controller plays at one difficulty.
+ */
+typedef struct ai_difficulty_settings_t {
+    const char *name;        /** Name of the difficulty. */
+    int reaction_units;      /** Number of time units before the controller reacts to a new direction of the ball. */
+    int max_error;           /** Maximal error of the prediction in half rows (see `draw_prediction_error()`). */
+    int max_speed;           /** Maximal number of rows the paddle moves in one time unit. */
+} ai_difficulty_settings_t;
+
+// ------------------------------------ GLOBAL VARIABLE----------------------------------------- //
+
+/**
+ * @brief Settings of the difficulties indexed by ai_difficulty_t. The paddle is 5 rows high, so an error of 2 rows
+ *        still hits the ball if the paddle gets to the target in time: the maximal errors of 5, 4 and 3 rows miss
+ *        about 25 %, 15 % and 4 % of the balls. The easy and normal paddles move equally fast, they differ in the reactions
+ *        and in the errors (the speed is a whole number of rows per time unit, and one row is already slow).
+ */
+static const ai_difficulty_settings_t gl_difficulty_settings[AI_DIFFICULTIES_COUNT] = {
+    { "easy",   6, 10, 1 },
+    { "normal", 3, 8, 1 },
+    { "hard",   0, 6, 2 }
+};
+
+// ---------------------------------- STATIC DECLARATIONS--------------------------------------- //
+
+static void update_prediction(ai_controller_t *controller, const ai_ball_t *ball, int paddle_x, px_t width, px_t height);
+static int draw_prediction_error(int max_error, random_t *random);
+
+// ----------------------------------------- PROGRAM-------------------------------------------- //
+
+void init_ai_controller(ai_controller_t *controller, ai_difficulty_t difficulty, nanoseconds_t step_duration, nanoseconds_t time_unit)
+{
+    controller->difficulty = difficulty;
+    controller->step_duration = step_duration;
+    controller->time_unit = time_unit;
+    reset_ai_controller(controller);
+}
+
+void reset_ai_controller(ai_controller_t *controller)
+{
+    controller->has_prediction = false;
+    controller->ball_x_speed = 0;
+    controller->ball_y_speed = 0;
+    controller->predicted_y = AI_NO_TARGET;
+    controller->prediction_error = 0;
+    controller->target_y = AI_NO_TARGET;
+    controller->reaction_time = 0;
+    controller->movement_budget = 0;
+}
+
+int compute_ai_paddle_movement(ai_controller_t *controller, const ai_ball_t *ball, int paddle_x, int paddle_center, px_t width, px_t height, random_t *random)
+{
+    const ai_difficulty_settings_t *settings = &gl_difficulty_settings[controller->difficulty];
+
+    // a new direction of the ball (a hit or a new round) needs a new reaction, a bounce off a border only
+    // updates the prediction (it stays the same unless the budget of the previous prediction ran out)
+    if (!controller->has_prediction || ball->x_speed != controller->ball_x_speed) {
+        controller->reaction_time = settings->reaction_units * controller->time_unit;
+        controller->prediction_error = draw_prediction_error(settings->max_error, random);
+        update_prediction(controller, ball, paddle_x, width, height);
+    } else if (ball->y_speed != controller->ball_y_speed) {
+        update_prediction(controller, ball, paddle_x, width, height);
+    }
+
+    // until the controller reacts, the paddle keeps heading to the previous target
+    if (controller->reaction_time > 0) {
+        controller->reaction_time -= controller->step_duration;
+    } else {
+        controller->target_y = controller->predicted_y;
+    }
+
+    if (controller->target_y == AI_NO_TARGET) {
+        return 0;
+    }
+
+    // the paddle gains max_speed rows per time unit, an idle paddle keeps at most the rows of one unit (or one step if it is longer)
+    nanoseconds_t budget_duration = (controller->step_duration > controller->time_unit) ? controller->step_duration : controller->time_unit;
+    controller->movement_budget += (int64_t)settings->max_speed * controller->step_duration;
+    if (controller->movement_budget > (int64_t)settings->max_speed * budget_duration) {
+        controller->movement_budget = (int64_t)settings->max_speed * budget_duration;
+    }
+    int max_movement = (int)(controller->movement_budget / controller->time_unit);
+
+    int movement = controller->target_y - paddle_center;
+    if (movement > max_movement) {
+        movement = max_movement;
+    } else if (movement < -max_movement) {
+        movement = -max_movement;
+    }
+
+    controller->movement_budget -= (int64_t)abs(movement) * controller->time_unit;
+    return movement;
+}
+
+int predict_ball_crossing(const ai_ball_t *ball, int column, px_t width, px_t height)
+{
+    int position_x = ball->position_x;
+    int position_y = ball->position_y;
+    int x_speed = ball->x_speed;
+    int y_speed = ball->y_speed;
+
+    // the same steps as move_ball() and bounce_ball() of the game
+    for (int i = 0; i < AI_PREDICTION_BUDGET; ++i) {
+        if (x_speed == 0 || (x_speed < 0 && position_x <= column) || (x_speed > 0 && position_x >= column)) {
+            break;
+        }
+
+        position_x += x_speed;
+        position_y += y_speed;
+
+        if (position_x >= (int)width - 2 || position_x <= 0) {
+            x_speed = -x_speed;
+        }
+        if (position_y >= (int)height - ball->height || position_y <= 0) {
+            y_speed = -y_speed;
+        }
+    }
+
+    return position_y + (ball->height / 2);
+}
+
+bool convert_string_2_ai_difficulty(const char *name, ai_difficulty_t *difficulty)
+{
+    for (int i = 0; i < AI_DIFFICULTIES_COUNT; ++i) {
+        if (strcmp(name, gl_difficulty_settings[i].name) == 0) {
+            *difficulty = (ai_difficulty_t)i;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+const char *ai_difficulty_2_string(ai_difficulty_t difficulty)
+{
+    return gl_difficulty_settings[difficulty].name;
+}
+
+/**
+ * @brief Computes the prediction for the current speed of the ball. A ball moving away from the paddle is not
+ *        predicted, the paddle returns to the middle of the game area instead.
+ *
+ * @param controller The controller.
+ * @param ball The ball.
+ * @param paddle_x The horizontal coordinate of the paddle.
+ * @param width The width of the game area.
+ * @param height The height of the game area.
+ */
+static void update_prediction(ai_controller_t *controller, const ai_ball_t *ball, int paddle_x, px_t width, px_t height)
+{
+    bool is_approaching = (ball->x_speed < 0 && paddle_x < ball->position_x) || (ball->x_speed > 0 && paddle_x > ball->position_x);
+
+    controller->has_prediction = true;
+    controller->ball_x_speed = ball->x_speed;
+    controller->ball_y_speed = ball->y_speed;
+
+    if (is_approaching) {
+        controller->predicted_y = predict_ball_crossing(ball, paddle_x, width, height) + controller->prediction_error;
+    } else {
+        controller->predicted_y = (int)height / 2;
+    }
+}
+
+/**
+ * @brief Draws the error of a prediction. The error is the sum of two uniform numbers, so small errors are more likely
+ *        than big ones (the distribution is triangular). It is drawn in half rows and rounded towards zero,
+ *        so the chances of missing the ball can be tuned more finely than by whole rows.
+ *
+ * @param max_error The maximal error in half rows.
+ * @param random The random number generator of the game.
+ * @return The error in rows.
+ */
+static int draw_prediction_error(int max_error, random_t *random)
+{
+    if (max_error == 0) {
+        return 0;
+    }
+
+    int half_rows = random_below(random, max_error + 1) + random_below(random, max_error + 1) - max_error;
+    return half_rows / 2;
+}
@@ -0,0 +1,141 @@
+/**
+ * @file ai.h
+ * @author Marek Eibel
+ * @brief Header file containing the computer controller of the paddles of InterStellar Pong.
+ *
+ * The controller predicts where the ball crosses the column of its paddle, including the bounces off the top
+ * and bottom borders, by running the same movement and bouncing rules as the game (`move_ball()` and
+ * `bounce_ball()`). The prediction takes at most AI_PREDICTION_BUDGET steps of the ball and it is cached:
+ * it is computed again only when the speed of the ball changes, so a controlled paddle usually costs a few
+ * comparisons per simulation step. This keeps the controller cheap enough for headless simulations.
+ *
+ * How well the controller plays is given by its difficulty: how long it takes to react to a new direction
+ * of the ball, how far off its predictions are and how fast it moves the paddle. The reaction time and the speed
+ * of the paddle are defined per time unit of the game and scaled by the duration of the simulation step, so the
+ * controller plays the same at any step rate. The predictions follow the ball in whole time units, so with
+ * shorter steps they can be off by a row where the ball bounces.
+ *
+ * @version 0.1
+ * @date 2023-10-06
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef AI_H
+#define AI_H
+
+#include <stdbool.h>
+
+#include "../termify/clock.h"
+#include "../termify/draw.h"
+#include "../termify/random.h"
+
+/**
+ * @brief Maximum number of steps of the ball simulated for one prediction. A ball which does not reach
+ *        the paddle within the budget is expected where the budget ended.
+ */
+#define AI_PREDICTION_BUDGET 256
+
+/**
+ * @brief Represents how well the computer plays.
+ */
+typedef enum ai_difficulty_t {
+    AI_EASY,                  /** Slow reactions and rough predictions (errors up to 5 rows). */
+    AI_NORMAL,                /** Short reactions and imprecise predictions (errors up to 4 rows). */
+    AI_HARD,                  /** Immediate reactions, small errors of the predictions (up to 3 rows) and a paddle twice as fast. */
+    AI_DIFFICULTIES_COUNT     /** Number of the difficulties. */
+} ai_difficulty_t;
+
+/**
+ * @struct ai_ball_t
+ * @brief The state of the ball seen by the controller.
+ */
+typedef struct ai_ball_t {
+    int position_x;    /** Horizontal coordinate of the ball. */
+    int position_y;    /** Vertical coordinate of the top of the ball. */
+    int height;        /** Height of the ball. */
+    int x_speed;       /** X-axis speed of the ball. */
+    int y_speed;       /** Y-axis speed of the ball. */
+} ai_ball_t;
+
+/**
+ * @struct ai_controller_t
+ * @brief Data structure representing the controller of one paddle and its cached prediction.
+ */
+typedef struct ai_controller_t {
+    ai_difficulty_t difficulty;   /** Difficulty of the controller. */
+    bool has_prediction;          /** Whether the cached prediction is valid. */
+    int ball_x_speed;             /** X-axis speed of the ball the prediction was computed for. */
+    int ball_y_speed;             /** Y-axis speed of the ball the prediction was computed for. */
+    int predicted_y;              /** Predicted vertical coordinate of the center of the ball in the column of the paddle (including the error). */
+    int prediction_error;         /** Error added to the current prediction, it is drawn once per direction of the ball. */
+    int target_y;                 /** Vertical coordinate the center of the paddle currently heads to. */
+    nanoseconds_t reaction_time;  /** Time left until the controller reacts to the prediction. */
+    int64_t movement_budget;      /** Distance the paddle may still move, in rows times nanoseconds (divided by `time_unit` to get rows). */
+    nanoseconds_t step_duration;  /** Duration of one simulation step. */
+    nanoseconds_t time_unit;      /** Time unit the reaction times and the speeds of the difficulties are defined in. */
+} ai_controller_t;
+
+/**
+ * @brief Initializes a controller without any prediction.
+ *
+ * @param controller The controller.
+ * @param difficulty The difficulty of the controller.
+ * @param step_duration The duration of one simulation step.
+ * @param time_unit The time unit of the game (the ball moves by its speed in one unit).
+ */
+void init_ai_controller(ai_controller_t *controller, ai_difficulty_t difficulty, nanoseconds_t step_duration, nanoseconds_t time_unit);
+
+/**
+ * @brief Drops the cached prediction. It has to be called when the ball is moved other than by its speed
+ *        (e.g. when it is put back to its initial position).
+ *
+ * @param controller The controller.
+ */
+void reset_ai_controller(ai_controller_t *controller);
+
+/**
+ * @brief Computes how many rows the paddle moves in this simulation step.
+ *
+ * @param controller The controller of the paddle.
+ * @param ball The ball.
+ * @param paddle_x The horizontal coordinate of the paddle.
+ * @param paddle_center The vertical coordinate of the center of the paddle.
+ * @param width The width of the game area.
+ * @param height The height of the game area.
+ * @param random The random number generator of the game (it is used only when the ball changes its direction).
+ * @return The number of rows to move the paddle by (negative values move it up).
+ */
+int compute_ai_paddle_movement(ai_controller_t *controller, const ai_ball_t *ball, int paddle_x, int paddle_center, px_t width, px_t height, random_t *random);
+
+/**
+ * @brief Predicts the vertical coordinate of the center of the ball when it reaches the column, following
+ *        the movement and bouncing rules of the game.
+ *
+ * @param ball The ball.
+ * @param column The horizontal coordinate of the column (the ball has to move towards it).
+ * @param width The width of the game area.
+ * @param height The height of the game area.
+ * @return The predicted vertical coordinate of the center of the ball.
+ */
+int predict_ball_crossing(const ai_ball_t *ball, int column, px_t width, px_t height);
+
+/**
+ * @brief Converts the name of a difficulty ("easy", "normal" or "hard") to the difficulty.
+ *
+ * @param name The name.
+ * @param difficulty Placeholder for the difficulty.
+ * @return true on success, false if there is no such difficulty.
+ */
+bool convert_string_2_ai_difficulty(const char *name, ai_difficulty_t *difficulty);
+
+/**
+ * @brief Gets the name of the difficulty.
+ *
+ * @param difficulty The difficulty.
+ * @return The name of the difficulty.
+ */
+const char *ai_difficulty_2_string(ai_difficulty_t difficulty);
+
+#endif
@@ -0,0 +1,409 @@
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "game_data.h"
+#include "interstellar_pong.h"
+#include "../termify/byte_buffer.h"
+
+// ---------------------------------------- MACROS --------------------------------------------- //
+
+#define FNV_OFFSET_BASIS 2166136261U
+#define FNV_PRIME 16777619U
+#define TEMPORARY_FILE_SUFFIX ".tmp"
+
+/**
+ * @struct game_data_image_header_t
+ * @brief The header of a compiled image of a game data file. The rows of the materials table follow it
+ *        and the rows of the levels table follow them.
+ */
+typedef struct game_data_image_header_t {
+    char magic[4];                            /** GAME_DATA_IMAGE_MAGIC without the terminating zero. */
+    uint32_t version;                         /** GAME_DATA_IMAGE_VERSION of the build which compiled the image. */
+    uint32_t checksum;                        /** FNV-1a checksum of the rows. */
+    uint32_t materials_count;                 /** Number of the rows of the materials table. */
+    uint32_t levels_count;                    /** Number of the rows of the levels table. */
+    uint32_t material_row_size;               /** Size of a row of the materials table in the build which compiled the image. */
+    uint32_t level_row_size;                  /** Size of a row of the levels table in the build which compiled the image. */
+    uint32_t reserved;                        /** Keeps the header aligned to 8 bytes. */
+    int64_t source_size;                      /** Size of the compiled data file. */
+    int64_t source_modification_seconds;      /** Modification time of the compiled data file (seconds). */
+    int64_t source_modification_nanoseconds;  /** Modification time of the compiled data file (nanoseconds). */
+} game_data_image_header_t;
+
+/**
+ * @struct game_data_cache_t
+ * @brief The loaded game data file and the state of the file when it was loaded.
+ */
+typedef struct game_data_cache_t {
+    char *file_path;                       /** Path of the cached file, or NULL if nothing is cached. */
+    game_data_t *game_data;                /** Data loaded from the file (or from its image). */
+    struct timespec modification_time;     /** Modification time of the file when it was loaded. */
+    off_t file_size;                       /** Size of the file when it was loaded. */
+} game_data_cache_t;
+
+// ------------------------------------ GLOBAL VARIABLE----------------------------------------- //
+
+/**
+ * @brief The cache of the game data file and the mutex guarding it and the references of all the data.
+ */
+static game_data_cache_t gl_cache = { NULL, NULL, { 0, 0 }, 0 };
+static pthread_mutex_t gl_cache_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+// ---------------------------------- STATIC DECLARATIONS--------------------------------------- //
+
+static bool is_cache_valid(const char *file_path, const struct stat *file_status);
+static bool replace_cache(const char *file_path, const char *image_path, const struct stat *file_status);
+static game_data_t *parse_game_data(const char *file_path);
+static game_data_t *map_game_data_image(const char *image_path, const struct stat *file_status);
+static bool check_image(const void *image, size_t image_size, const struct stat *file_status, const char *image_path);
+static uint32_t add_to_checksum(uint32_t checksum, const void *bytes, size_t count);
+static void drop_cached_data(void);
+static void drop_reference(game_data_t *game_data);
+
+// ----------------------------------------- PROGRAM-------------------------------------------- //
+
+game_data_t *acquire_game_data(const char *file_path, const char *image_path)
+{
+    struct stat file_status;
+    if (stat(file_path, &file_status) != 0) {
+        resolve_error(MISSING_DATA_FILE, file_path);
+        return NULL;
+    }
+
+    pthread_mutex_lock(&gl_cache_mutex);
+
+    // the file is loaded under the lock, so the games started at once wait for one loading instead of loading it each
+    if (!is_cache_valid(file_path, &file_status) && !replace_cache(file_path, image_path, &file_status)) {
+        pthread_mutex_unlock(&gl_cache_mutex);
+        return NULL;
+    }
+
+    game_data_t *game_data = gl_cache.game_data;
+    game_data->references++;
+
+    pthread_mutex_unlock(&gl_cache_mutex);
+
+    return game_data;
+}
+
+bool compile_game_data(const char *file_path, const char *image_path)
+{
+    // the state of the file is taken before it is read, so a file changed meanwhile makes the image stale
+    struct stat file_status;
+    if (stat(file_path, &file_status) != 0) {
+        resolve_error(MISSING_DATA_FILE, file_path);
+        return false;
+    }
+
+    game_data_t *game_data = parse_game_data(file_path);
+    if (game_data == NULL) {
+        return false;
+    }
+
+    const materials_table_t *materials_table = game_data->materials_table;
+    const levels_table_t *levels_table = game_data->levels_table;
+    size_t materials_size = sizeof(material_row_t) * materials_table->count;
+    size_t levels_size = sizeof(level_row_t) * levels_table->count;
+
+    game_data_image_header_t header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, GAME_DATA_IMAGE_MAGIC, sizeof(header.magic));
+    header.version = GAME_DATA_IMAGE_VERSION;
+    header.checksum = add_to_checksum(add_to_checksum(FNV_OFFSET_BASIS, materials_table->materials, materials_size), levels_table->levels, levels_size);
+    header.materials_count = (uint32_t)materials_table->count;
+    header.levels_count = (uint32_t)levels_table->count;
+    header.material_row_size = sizeof(material_row_t);
+    header.level_row_size = sizeof(level_row_t);
+    header.source_size = (int64_t)file_status.st_size;
+    header.source_modification_seconds = (int64_t)file_status.st_mtim.tv_sec;
+    header.source_modification_nanoseconds = (int64_t)file_status.st_mtim.tv_nsec;
+
+    char *temporary_path = malloc(strlen(image_path) + strlen(TEMPORARY_FILE_SUFFIX) + 1);
+    if (temporary_path == NULL) {
+        resolve_error(MEM_ALOC_FAILURE, NULL);
+        release_game_data(game_data);
+        return false;
+    }
+    sprintf(temporary_path, "%s%s", image_path, TEMPORARY_FILE_SUFFIX);
+
+    byte_buffer_t buffer;
+    init_byte_buffer(&buffer);
+
+    bool is_compiled = write_value(&buffer, header)
+                       && write_bytes(&buffer, materials_table->materials, materials_size)
+                       && write_bytes(&buffer, levels_table->levels, levels_size)
+                       && save_byte_buffer(&buffer, temporary_path);
+
+    if (is_compiled && rename(temporary_path, image_path) != 0) {
+        resolve_error(FAILURE_OF_RENAMING_FILE, temporary_path);
+        (void)remove(temporary_path);
+        is_compiled = false;
+    }
+
+    release_byte_buffer(&buffer);
+    free(temporary_path);
+    release_game_data(game_data);
+
+    return is_compiled;
+}
+
+game_data_t *create_game_data(materials_table_t *materials_table, levels_table_t *levels_table)
+{
+    game_data_t *game_data = malloc(sizeof(game_data_t));
+    if (game_data == NULL) {
+        resolve_error(MEM_ALOC_FAILURE, NULL);
+        release_materials_table(materials_table);
+        release_levels_table(levels_table);
+        return NULL;
+    }
+
+    game_data->materials_table = materials_table;
+    game_data->levels_table = levels_table;
+    game_data->references = 1;
+    game_data->image = NULL;
+    game_data->image_size = 0;
+
+    return game_data;
+}
+
+void release_game_data(game_data_t *game_data)
+{
+    if (game_data != NULL) {
+        pthread_mutex_lock(&gl_cache_mutex);
+        drop_reference(game_data);
+        pthread_mutex_unlock(&gl_cache_mutex);
+    }
+}
+
+void release_game_data_cache(void)
+{
+    pthread_mutex_lock(&gl_cache_mutex);
+    drop_cached_data();
+    pthread_mutex_unlock(&gl_cache_mutex);
+}
+
+/**
+ * @brief Checks whether the cached data belongs to the file in its current state. The caller holds the mutex.
+ *
+ * @param file_path The path of the file.
+ * @param file_status The current status of the file.
+ * @return true if the cached data can be used, false if the file has to be parsed.
+ */
+static bool is_cache_valid(const char *file_path, const struct stat *file_status)
+{
+    return gl_cache.file_path != NULL && strcmp(gl_cache.file_path, file_path) == 0
+           && gl_cache.file_size == file_status->st_size
+           && gl_cache.modification_time.tv_sec == file_status->st_mtim.tv_sec
+           && gl_cache.modification_time.tv_nsec == file_status->st_mtim.tv_nsec;
+}
+
+/**
+ * @brief Loads the file and caches its data instead of the previous one. The caller holds the mutex.
+ *        The data is mapped from the image if it is up to date, otherwise the file is parsed.
+ *        The status is taken before the file is read, so a file changed while it is loaded is loaded again next time.
+ *
+ * @param file_path The path of the file.
+ * @param image_path The path of the image of the file, or NULL.
+ * @param file_status The status of the file before it is loaded.
+ * @return true on success, false on failure (the previous data stays cached then).
+ */
+static bool replace_cache(const char *file_path, const char *image_path, const struct stat *file_status)
+{
+    char *cached_path = malloc(strlen(file_path) + 1);
+    if (cached_path == NULL) {
+        resolve_error(MEM_ALOC_FAILURE, NULL);
+        return false;
+    }
+
+    game_data_t *game_data = (image_path == NULL) ? NULL : map_game_data_image(image_path, file_status);
+    if (game_data == NULL && (game_data = parse_game_data(file_path)) == NULL) {
+        free(cached_path);
+        return false;
+    }
+
+    drop_cached_data();
+
+    gl_cache.file_path = strcpy(cached_path, file_path);
+    gl_cache.game_data = game_data;
+    gl_cache.modification_time = file_status->st_mtim;
+    gl_cache.file_size = file_status->st_size;
+
+    return true;
+}
+
+/**
+ * @brief Parses the game data file.
+ *
+ * @param file_path The path of the file.
+ * @return A pointer to the data with one reference, or NULL on invalid data or failure.
+ */
+static game_data_t *parse_game_data(const char *file_path)
+{
+    materials_table_t *materials_table;
+    levels_table_t *levels_table;
+    if (!load_extern_game_data(file_path, &materials_table, &levels_table)) {
+        return NULL;
+    }
+
+    return create_game_data(materials_table, levels_table);
+}
+
+/**
+ * @brief Maps the image of the game data file into memory. The tables point into the image, so the rows are
+ *        neither parsed nor copied. A missing or stale image is not an error, the file is parsed instead.
+ *
+ * @param image_path The path of the image.
+ * @param file_status The current status of the game data file.
+ * @return A pointer to the data with one reference, or NULL if the image cannot be used.
+ */
+static game_data_t *map_game_data_image(const char *image_path, const struct stat *file_status)
+{
+    int descriptor = open(image_path, O_RDONLY);
+    if (descriptor == -1) {
+        return NULL;
+    }
+
+    struct stat image_status;
+    if (fstat(descriptor, &image_status) != 0 || image_status.st_size < (off_t)sizeof(game_data_image_header_t)) {
+        close(descriptor);
+        return NULL;
+    }
+
+    // the mapping stays valid after the descriptor is closed and after the image is replaced by another one
+    size_t image_size = (size_t)image_status.st_size;
+    void *image = mmap(NULL, image_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    close(descriptor);
+    if (image == MAP_FAILED) {
+        return NULL;
+    }
+
+    game_data_t *game_data = NULL;
+    materials_table_t *materials_table = NULL;
+    levels_table_t *levels_table = NULL;
+    if (!check_image(image, image_size, file_status, image_path)
+        || (game_data = malloc(sizeof(game_data_t))) == NULL
+        || (materials_table = malloc(sizeof(materials_table_t))) == NULL
+        || (levels_table = malloc(sizeof(levels_table_t))) == NULL) {
+        free(game_data);
+        free(materials_table);
+        munmap(image, image_size);
+        return NULL;
+    }
+
+    const game_data_image_header_t *header = image;
+    unsigned char *rows = (unsigned char *)image + sizeof(game_data_image_header_t);
+
+    materials_table->materials = (material_row_t *)rows;
+    materials_table->count = (int)header->materials_count;
+    materials_table->length = (int)header->materials_count;
+
+    levels_table->levels = (level_row_t *)(rows + sizeof(material_row_t) * header->materials_count);
+    levels_table->count = (int)header->levels_count;
+    levels_table->length = (int)header->levels_count;
+
+    game_data->materials_table = materials_table;
+    game_data->levels_table = levels_table;
+    game_data->references = 1;
+    game_data->image = image;
+    game_data->image_size = image_size;
+
+    return game_data;
+}
+
+/**
+ * @brief Checks that the image was compiled by this build from the game data file in its current state
+ *        and that its rows are intact. Only a corrupted image is reported as an error.
+ *
+ * @param image The mapped image (at least as big as its header).
+ * @param image_size The size of the image.
+ * @param file_status The current status of the game data file.
+ * @param image_path The path of the image (used in the error message).
+ * @return true if the image can be used, false otherwise.
+ */
+static bool check_image(const void *image, size_t image_size, const struct stat *file_status, const char *image_path)
+{
+    const game_data_image_header_t *header = image;
+
+    if (memcmp(header->magic, GAME_DATA_IMAGE_MAGIC, sizeof(header->magic)) != 0 || header->version != GAME_DATA_IMAGE_VERSION
+        || header->material_row_size != sizeof(material_row_t) || header->level_row_size != sizeof(level_row_t)) {
+        return false;
+    }
+
+    if (header->source_size != (int64_t)file_status->st_size
+        || header->source_modification_seconds != (int64_t)file_status->st_mtim.tv_sec
+        || header->source_modification_nanoseconds != (int64_t)file_status->st_mtim.tv_nsec) {
+        return false;
+    }
+
+    // the game indexes the materials by their types, so all of them have to be in the image
+    size_t rows_size = sizeof(material_row_t) * (size_t)header->materials_count + sizeof(level_row_t) * (size_t)header->levels_count;
+    if (header->materials_count != MATERIALS_COUNT || header->levels_count == 0 || header->levels_count > INT32_MAX
+        || image_size != sizeof(game_data_image_header_t) + rows_size
+        || add_to_checksum(FNV_OFFSET_BASIS, (const unsigned char *)image + sizeof(game_data_image_header_t), rows_size) != header->checksum) {
+        resolve_error(INVALID_DATA_IN_FILE, image_path);
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Adds the bytes to the FNV-1a checksum.
+ *
+ * @param checksum The checksum so far.
+ * @param bytes The bytes.
+ * @param count The number of the bytes.
+ * @return The updated checksum.
+ */
+static uint32_t add_to_checksum(uint32_t checksum, const void *bytes, size_t count)
+{
+    const unsigned char *data = bytes;
+    for (size_t i = 0; i < count; ++i) {
+        checksum ^= data[i];
+        checksum *= FNV_PRIME;
+    }
+
+    return checksum;
+}
+
+/**
+ * @brief Drops the reference of the cache to its data and forgets the cached file. The caller holds the mutex.
+ */
+static void drop_cached_data(void)
+{
+    if (gl_cache.game_data != NULL) {
+        drop_reference(gl_cache.game_data);
+    }
+
+    free(gl_cache.file_path);
+    gl_cache.file_path = NULL;
+    gl_cache.game_data = NULL;
+}
+
+/**
+ * @brief Drops one reference to the data and releases the data with its last reference. The caller holds the mutex.
+ *
+ * @param game_data The data.
+ */
+static void drop_reference(game_data_t *game_data)
+{
+    if (--game_data->references == 0) {
+        if (game_data->image != NULL) {
+            // the rows belong to the image
+            free(game_data->materials_table);
+            free(game_data->levels_table);
+            munmap(game_data->image, game_data->image_size);
+        } else {
+            release_materials_table(game_data->materials_table);
+            release_levels_table(game_data->levels_table);
+        }
+        free(game_data);
+    }
+}
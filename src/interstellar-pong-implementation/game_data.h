@@ -0,0 +1,97 @@
+/**
+ * @file game_data.h
+ * @author Marek Eibel
+ * @brief Header file containing the shared game data (the materials and levels tables) of InterStellar Pong.
+ *
+ * The game data file is parsed once per process and the parsed tables are shared by all the games, which only
+ * read them. Every game holds a reference to its data, so the data lives as long as the last game using it.
+ * The cached data is checked against the modification time and the size of the file whenever it is acquired:
+ * a changed file is parsed again and the new games get the new data, while the running games keep theirs.
+ * Starting a game therefore costs a `stat()` of the file instead of reading and parsing it.
+ *
+ * The data file can be compiled by `compile_game_data()` into a binary image: a header with a version, a checksum
+ * and the state of the source file, followed by the rows of the tables with their sampling tables already built.
+ * The image is mapped into memory and the tables point right into it, so nothing is parsed or copied. An image
+ * which is missing, of another version or build, corrupted or older than the data file (its recorded modification
+ * time or size differs) is ignored and the data file is parsed instead. Like snapshots, the image is in the native
+ * byte order and layout.
+ *
+ * Acquiring and releasing the data is thread-safe, so games can be created on several threads.
+ *
+ * @version 0.1
+ * @date 2023-10-09
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef GAME_DATA_H
+#define GAME_DATA_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "levels.h"
+#include "materials.h"
+
+#define GAME_DATA_IMAGE_MAGIC "ISPD"
+#define GAME_DATA_IMAGE_VERSION 1
+
+/**
+ * @struct game_data_t
+ * @brief Data structure representing the materials and levels tables shared by games.
+ *
+ * The tables must not be modified once the data is shared.
+ */
+typedef struct game_data_t {
+    materials_table_t *materials_table;   /** Table containing data about materials. */
+    levels_table_t *levels_table;         /** Table containing data about game levels. */
+    int references;                       /** Number of the holders of the data (the cache is one of them while the data is cached). */
+    void *image;                          /** Mapped image the rows of the tables point into, or NULL if the tables were parsed. */
+    size_t image_size;                    /** Size of the mapped image. */
+} game_data_t;
+
+/**
+ * @brief Gets the data of the game data file. The data is loaded only if it is not cached yet, or if the modification
+ *        time or size of the file has changed since it was loaded. It is mapped from the image if the image is up to date,
+ *        otherwise the file is parsed.
+ *
+ * @param file_path The path of the game data file.
+ * @param image_path The path of the compiled image of the file, or NULL to always parse the file.
+ * @return A pointer to the shared data (it has to be released by `release_game_data()`), or NULL on failure.
+ */
+game_data_t *acquire_game_data(const char *file_path, const char *image_path);
+
+/**
+ * @brief Compiles the game data file into a binary image loadable by `acquire_game_data()`. The image is written
+ *        into a temporary file first and renamed then, so the games mapping the previous image are not disturbed.
+ *
+ * @param file_path The path of the game data file.
+ * @param image_path The path of the image.
+ * @return true on success, false on invalid data or failure.
+ */
+bool compile_game_data(const char *file_path, const char *image_path);
+
+/**
+ * @brief Creates data which is not cached, owned by the caller (e.g. the tables of a restored snapshot).
+ *        The tables are taken over by the data.
+ *
+ * @param materials_table The materials table.
+ * @param levels_table The levels table.
+ * @return A pointer to the data with one reference, or NULL on failure (the tables are released then).
+ */
+game_data_t *create_game_data(materials_table_t *materials_table, levels_table_t *levels_table);
+
+/**
+ * @brief Drops one reference to the data. The data is released with its last reference.
+ *
+ * @param game_data The data to release (NULL is ignored).
+ */
+void release_game_data(game_data_t *game_data);
+
+/**
+ * @brief Drops the cached data, so the next `acquire_game_data()` parses the file again.
+ *        The data is released once no game uses it. It is meant to be called before the program ends.
+ */
+void release_game_data_cache(void);
+
+#endif
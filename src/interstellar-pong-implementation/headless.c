@@ -0,0 +1,358 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "headless.h"
+#include "replay.h"
+#include "snapshot.h"
+#include "../termify/clock.h"
+#include "../termify/log.h"
+#include "../termify/thread_pool.h"
+
+/**
+ * @struct worker_results_t
+ * @brief Results summed by one worker of the simulation. Each worker has its own cache lines, so the workers
+ *        do not slow each other down by writing next to each other.
+ */
+typedef struct worker_results_t {
+    _Alignas(CACHE_LINE_SIZE) headless_results_t results;    /** Results of the games run by the worker. */
+    bool has_failed;                                         /** Whether a game of the worker could not be created. */
+} worker_results_t;
+
+/**
+ * @struct headless_simulation_t
+ * @brief Data structure representing the context shared by the workers of the simulation.
+ */
+typedef struct headless_simulation_t {
+    unsigned int seed;                   /** Seed of the first game. */
+    ai_difficulty_t enemy_difficulty;    /** Difficulty of the enemy in all the games. */
+    nanoseconds_t step_duration;         /** Duration of one simulation step of all the games. */
+    bool verify_snapshots;               /** Whether the snapshots of the games are verified. */
+    worker_results_t *workers_results;   /** Results of every worker. */
+} headless_simulation_t;
+
+// ---------------------------------- STATIC DECLARATIONS--------------------------------------- //
+
+static void add_game_to_results(const game_t *game, headless_results_t *results);
+static void play_game_to_end(game_t *game, pixel_buffer_t *collision_buffer, long max_steps, rewind_buffer_t *rewind_buffer, bool *has_failed);
+static bool verify_game_snapshots(game_t *game, pixel_buffer_t *collision_buffer, long max_steps, rewind_buffer_t *rewind_buffer, bool *is_matching);
+static double compute_mean(long sum, long count);
+static void simulate_game_task(int index, int worker, void *context);
+
+// ----------------------------------------- PROGRAM-------------------------------------------- //
+
+void init_headless_results(headless_results_t *results)
+{
+    results->games = 0;
+    results->player_wins = 0;
+    results->enemy_wins = 0;
+    results->unfinished_games = 0;
+    results->steps = 0;
+    results->paddle_hits = 0;
+    results->player_hearts_lost = 0;
+    results->enemy_hearts_lost = 0;
+    for (int i = 0; i < MATERIALS_COUNT; ++i) {
+        results->resources_collected[i] = 0;
+    }
+    results->level_ups = 0;
+    for (int i = 0; i < MAX_TRACKED_LEVELS; ++i) {
+        results->level_up_steps[i] = 0;
+        results->level_up_games[i] = 0;
+    }
+    results->verified_games = 0;
+    results->snapshot_mismatches = 0;
+}
+
+bool simulate_headless_game(unsigned int seed, ai_difficulty_t enemy_difficulty, nanoseconds_t step_duration, bool verify_snapshots,
+                            headless_results_t *results)
+{
+    game_t *game = init_game(NULL, HEADLESS_GAME_HEIGHT, HEADLESS_GAME_WIDTH, seed);
+    if (game == NULL) {
+        return false;
+    }
+    if (!set_game_step_duration(game, step_duration)) {
+        resolve_error(GENERAL_ERROR, "invalid duration of the simulation step.");
+        release_game(game);
+        return false;
+    }
+    game->is_player_ai = true;
+    init_ai_controller(&game->enemy_ai, enemy_difficulty, game->step_duration, GAME_SPEED_TIME_UNIT);
+
+    scene_t *scene = init_scene(game);
+    if (scene == NULL) {
+        release_game(game);
+        return false;
+    }
+
+    pixel_buffer_t *collision_buffer = create_pixel_buffer(HEADLESS_GAME_HEIGHT, HEADLESS_GAME_WIDTH);
+    if (collision_buffer == NULL) {
+        release_game(game);
+        return false;
+    }
+
+    rewind_buffer_t *rewind_buffer = NULL;
+    if (verify_snapshots && (rewind_buffer = create_rewind_buffer(HEADLESS_REWIND_SNAPSHOTS, HEADLESS_REWIND_INTERVAL)) == NULL) {
+        release_pixel_buffer(collision_buffer);
+        release_game(game);
+        return false;
+    }
+
+    long max_steps = HEADLESS_MAX_GAME_DURATION / step_duration;
+    bool has_failed = false;
+
+    start_game(game);
+    play_game_to_end(game, collision_buffer, max_steps, rewind_buffer, &has_failed);
+
+    if (!has_failed) {
+        add_game_to_results(game, results);
+    }
+
+    if (!has_failed && verify_snapshots) {
+        bool is_matching;
+        has_failed = !verify_game_snapshots(game, collision_buffer, max_steps, rewind_buffer, &is_matching);
+        results->verified_games++;
+        if (!is_matching) {
+            results->snapshot_mismatches++;
+        }
+    }
+
+    // the game releases its scene as well
+    release_rewind_buffer(rewind_buffer);
+    release_pixel_buffer(collision_buffer);
+    release_game(game);
+
+    return !has_failed;
+}
+
+void print_headless_results(const headless_results_t *results, double seconds, nanoseconds_t step_duration)
+{
+    const double STEPS_PER_SECOND = (double)NANOSECONDS_IN_SECOND / step_duration;
+    const char *MATERIAL_NAMES[MATERIALS_COUNT] = { "stone", "copper", "iron", "gold" };
+
+    long points = results->player_hearts_lost + results->enemy_hearts_lost;
+
+    printf("games:              %d (player won %d, enemy won %d, unfinished %d)\n",
+           results->games, results->player_wins, results->enemy_wins, results->unfinished_games);
+    printf("steps:              %ld (%.0f steps/s, %.2f s of wall time)\n",
+           results->steps, seconds > 0 ? results->steps / seconds : 0.0, seconds);
+    printf("steps per game:     %.1f (%.1f s of game time)\n",
+           compute_mean(results->steps, results->games), compute_mean(results->steps, results->games) / STEPS_PER_SECOND);
+    printf("paddle hits/rally:  %.2f\n", compute_mean(results->paddle_hits, points));
+    printf("hearts lost/game:   player %.2f, enemy %.2f\n",
+           compute_mean(results->player_hearts_lost, results->games), compute_mean(results->enemy_hearts_lost, results->games));
+
+    printf("resources/game:    ");
+    for (int i = 0; i < MATERIALS_COUNT; ++i) {
+        printf(" %s %.2f%s", MATERIAL_NAMES[i], compute_mean(results->resources_collected[i], results->games),
+               i + 1 < MATERIALS_COUNT ? "," : "\n");
+    }
+
+    printf("level-ups/game:     %.2f\n", compute_mean(results->level_ups, results->games));
+    if (results->verified_games > 0) {
+        printf("snapshots:          %d games verified, %d mismatches\n", results->verified_games, results->snapshot_mismatches);
+    }
+    for (int i = 0; i < MAX_TRACKED_LEVELS; ++i) {
+        if (results->level_up_games[i] == 0) {
+            continue;
+        }
+        double mean_steps = compute_mean(results->level_up_steps[i], results->level_up_games[i]);
+        printf("  level %2d left:    in %d games, after %.1f steps (%.1f s of game time) on average\n",
+               i, results->level_up_games[i], mean_steps, mean_steps / STEPS_PER_SECOND);
+    }
+}
+
+void merge_headless_results(headless_results_t *results, const headless_results_t *other)
+{
+    results->games += other->games;
+    results->player_wins += other->player_wins;
+    results->enemy_wins += other->enemy_wins;
+    results->unfinished_games += other->unfinished_games;
+    results->steps += other->steps;
+    results->paddle_hits += other->paddle_hits;
+    results->player_hearts_lost += other->player_hearts_lost;
+    results->enemy_hearts_lost += other->enemy_hearts_lost;
+    for (int i = 0; i < MATERIALS_COUNT; ++i) {
+        results->resources_collected[i] += other->resources_collected[i];
+    }
+    results->level_ups += other->level_ups;
+    for (int i = 0; i < MAX_TRACKED_LEVELS; ++i) {
+        results->level_up_steps[i] += other->level_up_steps[i];
+        results->level_up_games[i] += other->level_up_games[i];
+    }
+    results->verified_games += other->verified_games;
+    results->snapshot_mismatches += other->snapshot_mismatches;
+}
+
+int run_headless_simulation(int games_count, unsigned int seed, int threads_count, ai_difficulty_t enemy_difficulty, nanoseconds_t step_duration,
+                            bool verify_snapshots)
+{
+    if (threads_count > MAX_WORKERS) {
+        threads_count = MAX_WORKERS;
+    }
+    if (threads_count < 1) {
+        threads_count = 1;
+    }
+
+    char message[128];
+    snprintf(message, sizeof(message), "headless simulation of %d games on %d threads started with seed %u (%s enemy).",
+             games_count, threads_count, seed, ai_difficulty_2_string(enemy_difficulty));
+    log_message(LOG_FILE_PATH, message);
+
+    // aligned_alloc() needs the size to be a multiple of the alignment, which the padded results are
+    worker_results_t *workers_results = aligned_alloc(CACHE_LINE_SIZE, threads_count * sizeof(worker_results_t));
+    if (workers_results == NULL) {
+        resolve_error(MEM_ALOC_FAILURE, NULL);
+        return -1;
+    }
+    for (int i = 0; i < threads_count; ++i) {
+        init_headless_results(&workers_results[i].results);
+        workers_results[i].has_failed = false;
+    }
+
+    headless_simulation_t simulation = { seed, enemy_difficulty, step_duration, verify_snapshots, workers_results };
+
+    nanoseconds_t start = get_monotonic_time();
+    bool is_successful = run_parallel_for(games_count, threads_count, simulate_game_task, &simulation);
+    nanoseconds_t end = get_monotonic_time();
+
+    // every game has its own seed and the sums do not depend on the order, so any number of threads gives the same results
+    headless_results_t results;
+    init_headless_results(&results);
+    for (int i = 0; i < threads_count; ++i) {
+        merge_headless_results(&results, &workers_results[i].results);
+        is_successful = is_successful && !workers_results[i].has_failed;
+    }
+    free(workers_results);
+
+    if (!is_successful) {
+        return -1;
+    }
+
+    print_headless_results(&results, (double)(end - start) / NANOSECONDS_IN_SECOND, step_duration);
+    return (results.snapshot_mismatches == 0) ? 0 : -1;
+}
+
+/**
+ * @brief Adds the statistics of a finished game to the results.
+ *
+ * @param game The game.
+ * @param results The results.
+ */
+static void add_game_to_results(const game_t *game, headless_results_t *results)
+{
+    const game_stats_t *stats = &game->stats;
+
+    results->games++;
+    if (game->game_state != TERMINATED) {
+        results->unfinished_games++;
+    } else if (game->enemy->hearts <= 0) {
+        results->player_wins++;
+    } else {
+        results->enemy_wins++;
+    }
+
+    results->steps += stats->steps;
+    results->paddle_hits += stats->paddle_hits;
+    results->player_hearts_lost += stats->player_hearts_lost;
+    results->enemy_hearts_lost += stats->enemy_hearts_lost;
+    for (int i = 0; i < MATERIALS_COUNT; ++i) {
+        results->resources_collected[i] += stats->resources_collected[i];
+    }
+    results->level_ups += stats->level_ups;
+    for (int i = 0; i < MAX_TRACKED_LEVELS; ++i) {
+        if (stats->level_up_steps[i] != -1) {
+            results->level_up_steps[i] += stats->level_up_steps[i];
+            results->level_up_games[i]++;
+        }
+    }
+}
+
+/**
+ * @brief Runs the simulation steps of the game until it ends or until the limit of the steps is reached.
+ *
+ * @param game The game.
+ * @param collision_buffer The pixel buffer for the collisions of the game.
+ * @param max_steps The limit of the steps of the game.
+ * @param rewind_buffer The rewind buffer recording the snapshots of the game, or NULL.
+ * @param has_failed Placeholder set to true if a snapshot could not be recorded (the game is stopped then).
+ */
+static void play_game_to_end(game_t *game, pixel_buffer_t *collision_buffer, long max_steps, rewind_buffer_t *rewind_buffer, bool *has_failed)
+{
+    while (get_game_state(game) != TERMINATED && game->stats.steps < max_steps) {
+        reset_pixel_buffer(collision_buffer);
+        update_scene(game, collision_buffer);
+
+        if (rewind_buffer != NULL && !record_rewind_snapshot(rewind_buffer, game)) {
+            *has_failed = true;
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Verifies the snapshots of a game which has ended. A game created from the snapshot of the final state has to
+ *        have the same checksum, and the game rewound to its oldest snapshot has to end the same way when it is played again.
+ *
+ * @param game The game (it is rewound and played to its end again).
+ * @param collision_buffer The pixel buffer for the collisions of the game.
+ * @param max_steps The limit of the steps of the game.
+ * @param rewind_buffer The rewind buffer with the snapshots recorded during the game.
+ * @param is_matching Placeholder set to whether both restored games matched the original game.
+ * @return true on success, false on failure.
+ */
+static bool verify_game_snapshots(game_t *game, pixel_buffer_t *collision_buffer, long max_steps, rewind_buffer_t *rewind_buffer, bool *is_matching)
+{
+    uint32_t checksum = compute_game_checksum(game);
+    long steps = game->stats.steps;
+    *is_matching = false;
+
+    byte_buffer_t snapshot;
+    init_byte_buffer(&snapshot);
+    game_t *restored_game = take_game_snapshot(game, &snapshot) ? create_game_from_snapshot(&snapshot, NULL) : NULL;
+    release_byte_buffer(&snapshot);
+    if (restored_game == NULL) {
+        return false;
+    }
+    bool is_restored_matching = compute_game_checksum(restored_game) == checksum;
+    release_game(restored_game);
+
+    // the game has no snapshot if it ended before the first interval passed
+    if (rewind_buffer->count > 0 && !rewind_game(rewind_buffer, game, rewind_buffer->count - 1)) {
+        return false;
+    }
+
+    bool has_failed = false;
+    play_game_to_end(game, collision_buffer, max_steps, NULL, &has_failed);
+
+    *is_matching = is_restored_matching && compute_game_checksum(game) == checksum && game->stats.steps == steps;
+    return true;
+}
+
+/**
+ * @brief Computes the mean of a sum, returns 0 for an empty count.
+ *
+ * @param sum The sum of the values.
+ * @param count The number of the values.
+ * @return The mean.
+ */
+static double compute_mean(long sum, long count)
+{
+    return count == 0 ? 0.0 : (double)sum / count;
+}
+
+/**
+ * @brief Simulates the game with the given index, it is run by the thread pool.
+ *
+ * @param index The index of the game, its seed is the seed of the simulation plus the index.
+ * @param worker The index of the worker running the game.
+ * @param context The headless_simulation_t of the simulation.
+ */
+static void simulate_game_task(int index, int worker, void *context)
+{
+    headless_simulation_t *simulation = (headless_simulation_t *)context;
+    worker_results_t *worker_results = &simulation->workers_results[worker];
+
+    if (!simulate_headless_game(simulation->seed + (unsigned int)index, simulation->enemy_difficulty, simulation->step_duration,
+                                simulation->verify_snapshots, &worker_results->results)) {
+        worker_results->has_failed = true;
+    }
+}
@@ -0,0 +1,108 @@
+/**
+ * @file headless.h
+ * @author Marek Eibel
+ * @brief Header file containing the headless simulation of InterStellar Pong.
+ *
+ * The headless simulation runs games without any terminal: both paddles are moved by the computer, nothing is rendered
+ * and the simulation steps follow each other without any sleeping. The statistics of the games are summed up and
+ * printed, so changes of the game data (`res/game_data.ispdata`) can be evaluated before they are shipped.
+ * The games are independent of each other, so they are spread over all the processor cores.
+ *
+ * The simulation can also verify the snapshots of the games (see snapshot.h): every game records rewind snapshots,
+ * and when it ends, a game created from its final snapshot and the game rewound to its oldest snapshot and played
+ * again have to end with the same checksum (see `compute_game_checksum()`) as the original game.
+ *
+ * @version 0.1
+ * @date 2023-10-01
+ *
+ * @copyright Copyright (c) 2023
+ */
+
+#ifndef HEADLESS_H
+#define HEADLESS_H
+
+#include <stdbool.h>
+
+#include "interstellar_pong.h"
+
+#define HEADLESS_GAME_HEIGHT 22
+#define HEADLESS_GAME_WIDTH 80
+#define HEADLESS_MAX_GAME_DURATION (1000000L * GAME_SPEED_TIME_UNIT)
+#define HEADLESS_REWIND_SNAPSHOTS 8
+#define HEADLESS_REWIND_INTERVAL 100
+
+/**
+ * @struct headless_results_t
+ * @brief Summed statistics of the games of a headless simulation.
+ */
+typedef struct headless_results_t {
+    int games;                                      /** Number of simulated games. */
+    int player_wins;                                /** Number of games won by the player. */
+    int enemy_wins;                                 /** Number of games won by the enemy. */
+    int unfinished_games;                           /** Number of games stopped after HEADLESS_MAX_GAME_DURATION of game time. */
+    long steps;                                     /** Number of simulation steps of all the games. */
+    long paddle_hits;                               /** Number of hits of the ball by the paddles. */
+    long player_hearts_lost;                        /** Number of hearts lost by the player. */
+    long enemy_hearts_lost;                         /** Number of hearts lost by the enemy. */
+    long resources_collected[MATERIALS_COUNT];      /** Amounts of the collected resources (STONE, COPPER, IRON, GOLD). */
+    long level_ups;                                 /** Number of level-ups. */
+    long level_up_steps[MAX_TRACKED_LEVELS];        /** Sum of the steps in which the levels were left. */
+    int level_up_games[MAX_TRACKED_LEVELS];         /** Number of games in which the levels were left. */
+    int verified_games;                             /** Number of games whose snapshots were verified. */
+    int snapshot_mismatches;                        /** Number of verified games which did not end the same way after a restore. */
+} headless_results_t;
+
+/**
+ * @brief Initializes empty results.
+ *
+ * @param results The results to initialize.
+ */
+void init_headless_results(headless_results_t *results);
+
+/**
+ * @brief Simulates one game of the computer against the computer and adds its statistics to the results.
+ *
+ * @param seed The seed of the random numbers of the game.
+ * @param enemy_difficulty The difficulty of the enemy (the player plays at DEFAULT_AI_DIFFICULTY).
+ * @param step_duration The duration of one simulation step (see `set_game_step_duration()`).
+ * @param verify_snapshots Whether the snapshots of the game are verified as well.
+ * @param results The results to add the game to.
+ * @return true on success, false on failure.
+ */
+bool simulate_headless_game(unsigned int seed, ai_difficulty_t enemy_difficulty, nanoseconds_t step_duration, bool verify_snapshots,
+                            headless_results_t *results);
+
+/**
+ * @brief Prints the results in a human readable form to the standard output.
+ *
+ * @param results The results to print.
+ * @param seconds The wall time spent in the simulation.
+ * @param step_duration The duration of one simulation step of the games (it converts the steps to the game time).
+ */
+void print_headless_results(const headless_results_t *results, double seconds, nanoseconds_t step_duration);
+
+/**
+ * @brief Adds the results of other games to the results.
+ *
+ * @param results The results to add to.
+ * @param other The results to add.
+ */
+void merge_headless_results(headless_results_t *results, const headless_results_t *other);
+
+/**
+ * @brief Simulates the given number of games on a pool of threads and prints their statistics. The games get
+ *        the seeds <seed>, <seed> + 1, ..., so the whole simulation can be repeated with any number of threads.
+ *        Every thread sums the results of its games separately, they are merged once all the games are over.
+ *
+ * @param games_count The number of games to simulate.
+ * @param seed The seed of the first game.
+ * @param threads_count The number of threads (at least 1, use `get_available_cores()` for all the cores).
+ * @param enemy_difficulty The difficulty of the enemy (the player plays at DEFAULT_AI_DIFFICULTY).
+ * @param step_duration The duration of one simulation step of the games.
+ * @param verify_snapshots Whether the snapshots of the games are verified as well.
+ * @return 0 on success, -1 on failure or if a verified game did not end the same way after a restore.
+ */
+int run_headless_simulation(int games_count, unsigned int seed, int threads_count, ai_difficulty_t enemy_difficulty, nanoseconds_t step_duration,
+                            bool verify_snapshots);
+
+#endif
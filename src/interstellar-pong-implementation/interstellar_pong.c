@@ -1,4 +1,3 @@
-#include <time.h>
 #include <unistd.h>
 
 #include "interstellar_pong.h"
@@ -18,57 +17,55 @@
 
 // ---------------------------------- STATIC DECLARATIONS--------------------------------------- //
 
-static bool create_rectangle_and_add_it_to_scene(scene_t *scene, px_t position_x, px_t position_y, px_t width, px_t height, px_t x_speed, px_t y_speed, colour_t colour, const char *name);
-static void set_meteor_properties(rectangle_t *meteor, int player_level, levels_table_t *levels, materials_table_t *materials, int width, int height);
-static material_type_t count_meteor_material_from_level(level_row_t level);
-static void simulate_enemy_paddle_movement(rectangle_t *enemy, rectangle_t *ball, px_t height);
+static ID_t create_rectangle_and_add_it_to_scene(scene_t *scene, px_t position_x, px_t position_y, px_t width, px_t height, px_t x_speed, px_t y_speed, colour_t colour, const char *name);
+static void set_meteor_properties(scene_t *scene, ID_t meteor, int player_level, const levels_table_t *levels, const materials_table_t *materials, int width, int height, random_t *random);
+static material_type_t count_meteor_material_from_level(const level_row_t *level, random_t *random);
+static void simulate_ai_paddle_movement(scene_t *scene, ID_t paddle, ID_t ball, ai_controller_t *controller, px_t width, px_t height, random_t *random);
 static bool convert_line_into_material_data(materials_table_t *table, char *line, int counter, const char *file_path);
-static void handle_ball_and_paddle_collision(rectangle_t *ball, rectangle_t *paddle);
-static void handle_ball_and_meteor_collision(rectangle_t *meteor, game_t *game);
-static int compute_cumulative_distribution(const int *probabilities, int count);
-static void set_meteor_shape(rectangle_t *meteor, materials_table_t *materials);
-static void set_meteor_size(rectangle_t *meteor, materials_table_t *materials);
-static bool check_for_level_update(player_t *player, levels_table_t *levels);
+static void handle_ball_and_paddle_collision(scene_t *scene, ID_t ball, ID_t paddle);
+static void handle_ball_and_meteor_collision(ID_t meteor, game_t *game);
+static void set_meteor_shape(scene_t *scene, ID_t meteor, const materials_table_t *materials, random_t *random);
+static void set_meteor_size(scene_t *scene, ID_t meteor, const materials_table_t *materials, random_t *random);
+static bool check_for_level_update(player_t *player, const levels_table_t *levels);
 static bool convert_line_into_level_data(levels_table_t *table, char *line, const char *file_path);
-static bool check_ball_boundary_collision(rectangle_t *ball, game_t *game);
-static void update_player_resources(rectangle_t *meteor, player_t *player);
+static bool check_ball_boundary_collision(ID_t ball, game_t *game);
+static int update_player_resources(scene_t *scene, ID_t meteor, player_t *player);
 static int get_index_based_on_material_type(material_type_t material);
-static bool detect_collision(ID_t collision_ID, rectangle_t *object);
-static void bounce_ball(rectangle_t *ball, px_t width, px_t height);
+static bool detect_collision(collisions_t *collisions, ID_t object);
+static bool has_ball_entered_paddle_columns(scene_t *scene, ID_t ball, ID_t paddle);
+static void bounce_ball(scene_t *scene, ID_t ball, px_t width, px_t height);
 static material_type_t get_material_type_based_on_index(int index);
-static rectangle_t *find_object(game_t *game, const char *name);
-static material_shape_t get_meteors_shape(rectangle_t *meteor);
+static material_shape_t get_meteors_shape(scene_t *scene, ID_t meteor);
 static void set_objects_to_initial_position(game_t *game);
 static void update_player_to_next_level(game_t *game);
-static void test_meteors_generator(int tested_level); // TODO this should not be compiled in release mode
-static void swap_sides(rectangle_t *meteor);
+static void swap_sides(scene_t *scene, ID_t meteor, random_t *random);
 static void reset_game_ticks(game_t *game);
-static void move_ball(rectangle_t *ball);
+static void move_ball(game_t *game);
 
 static int get_width(game_t *game);
 static int get_height(game_t *game);
-static ID_t get_ID(rectangle_t *object);
 static int get_game_ticks(game_t *game);
-static char *get_name(rectangle_t *object);
-static int get_x_speed(rectangle_t *object);
-static int get_y_speed(rectangle_t *object);
+static int get_alive_object_index(scene_t *scene, ID_t object);
+static char *get_name(scene_t *scene, ID_t object);
+static int get_x_speed(scene_t *scene, ID_t object);
+static int get_y_speed(scene_t *scene, ID_t object);
 static void increment_game_ticks(game_t *game);
-static int get_x_position(rectangle_t *object);
-static int get_y_position(rectangle_t *object);
-static colour_t get_colour(rectangle_t *object);
-static int get_rectangle_width(rectangle_t *object);
-static int get_rectangle_height(rectangle_t *object);
-static void set_x_speed(rectangle_t *object, int speed);
-static void set_y_speed(rectangle_t *object, int speed);
-static void set_colour(rectangle_t *object, colour_t colour);
-static void set_rectangle_width(rectangle_t *object, px_t size);
-static void set_rectangle_height(rectangle_t *object, px_t size);
-static void set_x_position(rectangle_t *object, px_t position);
-static void set_y_position(rectangle_t *object, px_t position);
+static int get_x_position(scene_t *scene, ID_t object);
+static int get_y_position(scene_t *scene, ID_t object);
+static colour_t get_colour(scene_t *scene, ID_t object);
+static int get_rectangle_width(scene_t *scene, ID_t object);
+static int get_rectangle_height(scene_t *scene, ID_t object);
+static void set_x_speed(scene_t *scene, ID_t object, int speed);
+static void set_y_speed(scene_t *scene, ID_t object, int speed);
+static void set_colour(scene_t *scene, ID_t object, colour_t colour);
+static void set_rectangle_width(scene_t *scene, ID_t object, px_t size);
+static void set_rectangle_height(scene_t *scene, ID_t object, px_t size);
+static void set_x_position(scene_t *scene, ID_t object, px_t position);
+static void set_y_position(scene_t *scene, ID_t object, px_t position);
 
 // ----------------------------------------- PROGRAM-------------------------------------------- //
 
-game_t *init_game(player_t *player, px_t height, px_t width)
+game_t *init_game(player_t *player, px_t height, px_t width, uint64_t seed)
 {
     game_t *game = malloc(sizeof(game_t));
     if (game == NULL) {
@@ -81,6 +78,20 @@ game_t *init_game(player_t *player, px_t height, px_t width)
     game->game_state = TERMINATED;
     game->scene = NULL;
     game->game_ticks = 0;
+    game->countdown_time = 0;
+    game->step_duration = DEFAULT_GAME_STEP_DURATION;
+    game->ball_remainder_x = 0;
+    game->ball_remainder_y = 0;
+    game->is_player_ai = false;
+    game->replay = NULL;
+    init_ai_controller(&game->enemy_ai, DEFAULT_AI_DIFFICULTY, game->step_duration, GAME_SPEED_TIME_UNIT);
+    init_ai_controller(&game->player_ai, DEFAULT_AI_DIFFICULTY, game->step_duration, GAME_SPEED_TIME_UNIT);
+
+    memset(&game->stats, 0, sizeof(game->stats));
+    for (int i = 0; i < MAX_TRACKED_LEVELS; ++i) {
+        game->stats.level_up_steps[i] = -1;
+    }
+
     game->enemy = create_player("enemy", 0, 0, 0, 0, 0);
     if (game->enemy == NULL) {
         resolve_error(MEM_ALOC_FAILURE, NULL);
@@ -103,20 +114,32 @@ game_t *init_game(player_t *player, px_t height, px_t width)
 
     game->player_choosen_to_game = player;
 
-    game->materials_table = NULL;
-    game->levels_table = NULL;
-
-    if (!load_extern_game_data(GAME_DATA_PATH, &game->materials_table, &game->levels_table)) {
+    // the data file is parsed only by the first game (or after the file has changed)
+    game->game_data = acquire_game_data(GAME_DATA_PATH, GAME_DATA_IMAGE_PATH);
+    if (game->game_data == NULL) {
         release_player(game->player);
         release_player(game->enemy);
         free(game);
         return NULL;
     }
 
-    srand(time(NULL));
+    game->seed = seed;
+    seed_random(&game->random, seed);
     return game;
 }
 
+bool set_game_step_duration(game_t *game, nanoseconds_t step_duration)
+{
+    if (step_duration < MIN_GAME_STEP_DURATION || step_duration > GAME_SPEED_TIME_UNIT) {
+        return false;
+    }
+
+    game->step_duration = step_duration;
+    init_ai_controller(&game->enemy_ai, game->enemy_ai.difficulty, step_duration, GAME_SPEED_TIME_UNIT);
+    init_ai_controller(&game->player_ai, game->player_ai.difficulty, step_duration, GAME_SPEED_TIME_UNIT);
+    return true;
+}
+
 void start_game(game_t *game)
 {
     game->game_state = RUNNING;
@@ -135,6 +158,12 @@ void end_game(game_t *game)
 void stop_game(game_t *game)
 {
     game->game_state = STOPPED;
+    game->countdown_time = ROUND_COUNTDOWN_DURATION;
+}
+
+nanoseconds_t get_countdown_time(game_t *game)
+{
+    return (game->game_state == STOPPED) ? game->countdown_time : 0;
 }
 
 void release_game(game_t *game)
@@ -143,8 +172,8 @@ void release_game(game_t *game)
         release_player(game->player);
         release_player(game->enemy);
         release_scene(game->scene);
-        release_materials_table(game->materials_table);
-        release_levels_table(game->levels_table);
+        release_game_data(game->game_data);
+        release_replay(game->replay);
         free(game);
     }
 }
@@ -157,59 +186,87 @@ scene_t *init_scene(game_t *game)
         return NULL;
     }
 
-    if (!create_rectangle_and_add_it_to_scene(scene, BALL_INIT_X_COORD, BALL_INIT_Y_COORD, 1, 1, 2, 1, WHITE, "ball") ||
-        !create_rectangle_and_add_it_to_scene(scene, PLAYER_INIT_X_COORD, PLAYER_INIT_Y_COORD, 1, 5, 0, 0, GREEN, "player") ||
-        !create_rectangle_and_add_it_to_scene(scene, 15, 13, 0, 0, 0, 0, (colour_t)STONE, "meteor_1") ||
-        !create_rectangle_and_add_it_to_scene(scene, 50, 5, 0, 0, 0, 0, (colour_t)STONE, "meteor_2") ||
-        !create_rectangle_and_add_it_to_scene(scene, ENEMY_INIT_X_COORD, ENEMY_INIT_Y_COORD, 1, 5, 0, 0, RED, "enemy")) {
+    game_actors_t *actors = &game->actors;
+
+    // the meteors are placed randomly by respawn_meteor() below
+    if ((actors->ball = create_rectangle_and_add_it_to_scene(scene, BALL_INIT_X_COORD, BALL_INIT_Y_COORD, 1, 1, 2, 1, WHITE, "ball")) == UNDEFINIED_ID ||
+        (actors->player_paddle = create_rectangle_and_add_it_to_scene(scene, PLAYER_INIT_X_COORD, PLAYER_INIT_Y_COORD, 1, 5, 0, 0, GREEN, "player")) == UNDEFINIED_ID ||
+        (actors->meteors[0] = create_rectangle_and_add_it_to_scene(scene, 0, 0, 0, 0, 0, 0, (colour_t)STONE, "meteor_1")) == UNDEFINIED_ID ||
+        (actors->meteors[1] = create_rectangle_and_add_it_to_scene(scene, 0, 0, 0, 0, 0, 0, (colour_t)STONE, "meteor_2")) == UNDEFINIED_ID ||
+        (actors->enemy_paddle = create_rectangle_and_add_it_to_scene(scene, ENEMY_INIT_X_COORD, ENEMY_INIT_Y_COORD, 1, 5, 0, 0, RED, "enemy")) == UNDEFINIED_ID) {
         return NULL;
     }
 
     game->scene = scene;
 
-    set_meteor_properties(find_object(game, "meteor_1"), game->player->level, game->levels_table, game->materials_table, get_width(game), get_height(game));
-    set_meteor_properties(find_object(game, "meteor_2"), game->player->level, game->levels_table, game->materials_table, get_width(game), get_height(game));
+    for (int i = 0; i < METEORS_COUNT; ++i) {
+        respawn_meteor(game, actors->meteors[i]);
+    }
 
     return game->scene;
 }
 
+void respawn_meteor(game_t *game, ID_t meteor)
+{
+    set_meteor_properties(game->scene, meteor, game->player->level, game->game_data->levels_table, game->game_data->materials_table, get_width(game), get_height(game), &game->random);
+}
+
 scene_t *update_scene(game_t *game, pixel_buffer_t *pixel_buffer)
 {
-    rectangle_t *ball = find_object(game, "ball");
-    rectangle_t *player = find_object(game, "player");
-    rectangle_t *enemy = find_object(game, "enemy");
-    rectangle_t *meteor_1 = find_object(game, "meteor_1");
-    rectangle_t *meteor_2 = find_object(game, "meteor_2");
+    scene_t *scene = game->scene;
+    ID_t ball = game->actors.ball;
+    ID_t player = game->actors.player_paddle;
+    ID_t enemy = game->actors.enemy_paddle;
+    const ID_t *meteors = game->actors.meteors;
+
+    // the rendering interpolates between the positions before and after this step
+    save_scene_positions(scene);
+    game->stats.steps++;
+
+    // the objects wait at their initial positions until the countdown is over
+    if (game->game_state == STOPPED) {
+        game->countdown_time -= game->step_duration;
+        if (game->countdown_time <= 0) {
+            start_game(game);
+        }
+        return game->scene;
+    }
 
-    move_ball(ball);
-    bounce_ball(ball, game->width, game->height);
-    simulate_enemy_paddle_movement(enemy, ball, game->height);
+    move_ball(game);
+    bounce_ball(scene, ball, game->width, game->height);
+    simulate_ai_paddle_movement(scene, enemy, ball, &game->enemy_ai, game->width, game->height, &game->random);
+    if (game->is_player_ai) {
+        simulate_ai_paddle_movement(scene, player, ball, &game->player_ai, game->width, game->height, &game->random);
+    }
 
     // put objects pixel in pixel buffer
-    (void)compute_object_pixels_in_buffer(pixel_buffer, player);
-    (void)compute_object_pixels_in_buffer(pixel_buffer, meteor_1);
-    (void)compute_object_pixels_in_buffer(pixel_buffer, meteor_2);
-    (void)compute_object_pixels_in_buffer(pixel_buffer, enemy);
+    (void)compute_object_pixels_in_buffer(pixel_buffer, scene, player, NULL);
+    for (int i = 0; i < METEORS_COUNT; ++i) {
+        (void)compute_object_pixels_in_buffer(pixel_buffer, scene, meteors[i], NULL);
+    }
+    (void)compute_object_pixels_in_buffer(pixel_buffer, scene, enemy, NULL);
 
     // collision detection and handling
-    ID_t collision_ID = compute_object_pixels_in_buffer(pixel_buffer, ball);
-    if (detect_collision(collision_ID, player)) {
+    collisions_t collisions;
+    init_collisions(&collisions);
+    (void)compute_object_pixels_in_buffer(pixel_buffer, scene, ball, &collisions);
+    if (detect_collision(&collisions, player) && has_ball_entered_paddle_columns(scene, ball, player)) {
         increment_game_ticks(game);
-        handle_ball_and_paddle_collision(ball, player);
+        game->stats.paddle_hits++;
+        handle_ball_and_paddle_collision(scene, ball, player);
     }
-    if (detect_collision(collision_ID, enemy)) {
+    if (detect_collision(&collisions, enemy) && has_ball_entered_paddle_columns(scene, ball, enemy)) {
         increment_game_ticks(game);
-        handle_ball_and_paddle_collision(ball, enemy);
-    }
-    if (detect_collision(collision_ID, meteor_1)) {
-        clear_object_pixels_in_buffer(pixel_buffer, meteor_1);
-        handle_ball_and_meteor_collision(meteor_1, game);
-
+        game->stats.paddle_hits++;
+        handle_ball_and_paddle_collision(scene, ball, enemy);
     }
-    if (detect_collision(collision_ID, meteor_2)) {
-        clear_object_pixels_in_buffer(pixel_buffer, meteor_2);
-        handle_ball_and_meteor_collision(meteor_2, game);
+    for (int i = 0; i < METEORS_COUNT; ++i) {
+        if (detect_collision(&collisions, meteors[i])) {
+            clear_object_pixels_in_buffer(pixel_buffer, scene, meteors[i]);
+            handle_ball_and_meteor_collision(meteors[i], game);
+        }
     }
+    release_collisions(&collisions);
 
     // check ball and bouderies
     if (!check_ball_boundary_collision(ball, game)) {
@@ -220,8 +277,9 @@ scene_t *update_scene(game_t *game, pixel_buffer_t *pixel_buffer)
     if (game->game_ticks > 15) {
         increment_game_ticks(game);
         reset_game_ticks(game);
-        set_meteor_properties(meteor_1, game->player->level, game->levels_table, game->materials_table, get_width(game), get_height(game));
-        set_meteor_properties(meteor_2, game->player->level, game->levels_table, game->materials_table, get_width(game), get_height(game));
+        for (int i = 0; i < METEORS_COUNT; ++i) {
+            respawn_meteor(game, meteors[i]);
+        }
     }
 
     // end game
@@ -230,35 +288,54 @@ scene_t *update_scene(game_t *game, pixel_buffer_t *pixel_buffer)
     }
 
     // check the level update
-    if (check_for_level_update(game->player, game->levels_table)) {
+    if (check_for_level_update(game->player, game->game_data->levels_table)) {
         update_player_to_next_level(game);
     }
 
     return game->scene;
 }
 
-void handle_event(game_t *game, char c)
+void handle_event(game_t *game, int key)
 {
-    rectangle_t *player = find_object(game, "player");
-    if (KEYBOARD_PRESSED(c, 'w') || KEYBOARD_PRESSED(c, 'W')) {
+    scene_t *scene = game->scene;
+    ID_t player = game->actors.player_paddle;
+
+    // only the keys which change the game are recorded
+    bool is_quit_key = KEYBOARD_PRESSED(key, 'q') || KEYBOARD_PRESSED(key, 'Q');
+    if (game->replay != NULL && (is_movement_key(key) || is_quit_key)) {
+        // a replay with a missing key would not match its checksum, so the game is not recorded further
+        if (!record_replay_event(game->replay, game->stats.steps, key)) {
+            log_warning(LOG_FILE_PATH, "the game is not recorded any more, a key could not be added to the replay.");
+            release_replay(game->replay);
+            game->replay = NULL;
+        }
+    }
+
+    if (KEYBOARD_PRESSED(key, 'w') || KEYBOARD_PRESSED(key, 'W') || KEYBOARD_PRESSED(key, KEY_ARROW_UP)) {
 
-        set_y_position(player, get_y_position(player) - 2);
-        if (get_y_position(player) - 2 < 0) {
-            set_y_position(player, 0);
+        set_y_position(scene, player, get_y_position(scene, player) - 2);
+        if (get_y_position(scene, player) - 2 < 0) {
+            set_y_position(scene, player, 0);
         }
 
-    } else if (KEYBOARD_PRESSED(c, 's') || KEYBOARD_PRESSED(c, 'S')) {
+    } else if (KEYBOARD_PRESSED(key, 's') || KEYBOARD_PRESSED(key, 'S') || KEYBOARD_PRESSED(key, KEY_ARROW_DOWN)) {
 
-        set_y_position(player, get_y_position(player) + 2);
-        if (get_y_position(player) > game->height - get_rectangle_height(player)) {
-            set_y_position(player, game->height - get_rectangle_height(player));
+        set_y_position(scene, player, get_y_position(scene, player) + 2);
+        if (get_y_position(scene, player) > game->height - get_rectangle_height(scene, player)) {
+            set_y_position(scene, player, game->height - get_rectangle_height(scene, player));
         }
 
-    } else if (KEYBOARD_PRESSED(c, 'q') || KEYBOARD_PRESSED(c, 'Q')) {
+    } else if (is_quit_key) {
         end_game(game);
     }
 }
 
+bool is_movement_key(int key)
+{
+    return KEYBOARD_PRESSED(key, 'w') || KEYBOARD_PRESSED(key, 'W') || KEYBOARD_PRESSED(key, KEY_ARROW_UP) ||
+           KEYBOARD_PRESSED(key, 's') || KEYBOARD_PRESSED(key, 'S') || KEYBOARD_PRESSED(key, KEY_ARROW_DOWN);
+}
+
 bool load_extern_game_data(const char *file_path, materials_table_t **materials_table, levels_table_t **levels_table)
 {
     const char COMMENT = '#';
@@ -347,17 +424,27 @@ bool load_extern_game_data(const char *file_path, materials_table_t **materials_
  */
 static void update_player_to_next_level(game_t *game)
 {
+    const levels_table_t *levels = game->game_data->levels_table;
     int level = game->player->level;
 
-    if (level <= game->levels_table->count - 1) {
-        game->player->stone -= game->levels_table->levels[level].stone_request;
-        game->player_choosen_to_game->stone -= game->levels_table->levels[level].stone_request;
-        game->player->copper -= game->levels_table->levels[level].copper_request;
-        game->player_choosen_to_game->copper -= game->levels_table->levels[level].copper_request;
-        game->player->iron -= game->levels_table->levels[level].iron_request;
-        game->player_choosen_to_game->iron -= game->levels_table->levels[level].iron_request;
-        game->player->gold -= game->levels_table->levels[level].gold_request;
-        game->player_choosen_to_game->gold -= game->levels_table->levels[level].gold_request;
+    if (level <= levels->count - 1) {
+        game->player->stone -= levels->levels[level].stone_request;
+        game->player->copper -= levels->levels[level].copper_request;
+        game->player->iron -= levels->levels[level].iron_request;
+        game->player->gold -= levels->levels[level].gold_request;
+
+        // games without a player account have no player to update
+        if (game->player_choosen_to_game != NULL) {
+            game->player_choosen_to_game->stone -= levels->levels[level].stone_request;
+            game->player_choosen_to_game->copper -= levels->levels[level].copper_request;
+            game->player_choosen_to_game->iron -= levels->levels[level].iron_request;
+            game->player_choosen_to_game->gold -= levels->levels[level].gold_request;
+        }
+
+        game->stats.level_ups++;
+        if (level < MAX_TRACKED_LEVELS) {
+            game->stats.level_up_steps[level] = game->stats.steps;
+        }
 
         game->player->hearts = 3;
         game->enemy->hearts = 3;
@@ -365,7 +452,7 @@ static void update_player_to_next_level(game_t *game)
 
         reset_game_ticks(game);
         set_objects_to_initial_position(game);
-        game->game_state = STOPPED;
+        stop_game(game);
         increment_game_ticks(game);
     }
 }
@@ -379,7 +466,7 @@ static void update_player_to_next_level(game_t *game)
  * @param levels A pointer to the levels table.
  * @return true if the player can advance to the next level, false otherwise.
  */
-static bool check_for_level_update(player_t *player, levels_table_t *levels)
+static bool check_for_level_update(player_t *player, const levels_table_t *levels)
 {
     int level = player->level;
     if (level > levels->count - 1) {
@@ -451,54 +538,20 @@ static int get_index_based_on_material_type(material_type_t material)
     }
 }
 
-/**
- * @brief Computes the cumulative distribution and choose a random index based on probabilities.
- *
- * This function computes the cumulative distribution of the given probabilities array and then chooses a random index
- * based on these cumulative probabilities. The probabilities array is assumed to contain integer values representing
- * probabilities for each element.
- *
- * @param probabilities An array of probabilities for each element.
- * @param count The number of elements in the probabilities array.
- * @return The chosen index based on probabilities (starting on 0), or -1 if an error occurs.
- */
-static int compute_cumulative_distribution(const int *probabilities, int count)
-{
-    int cumulative_probabilities[count];
-
-    int cumulative = 0;
-    for (int i = 0; i < count; ++i) {
-        cumulative += probabilities[i];
-        cumulative_probabilities[i] = cumulative;
-    }
-
-    int random_number = rand() % 100 + 1;
-
-    for (int i = 0; i < count; ++i) {
-        if (random_number <= cumulative_probabilities[i]) {
-            return i;
-        }
-    }
-
-    return -1;
-}
-
 /**
  * @brief Sets the size of a meteor object based on material probabilities.
  *
- * This function calculates the size of a meteor object based on the given materials' probabilities.
+ * This function draws the size of a meteor object from the precomputed distribution of the sizes of its material.
  *
- * @param meteor Pointer to the rectangle_t structure representing the meteor object.
+ * @param scene The scene holding the objects.
+ * @param meteor The ID of the meteor object.
  * @param materials Pointer to the materials_table_t structure containing material probabilities.
+ * @param random The random number generator of the game.
  */
-static void set_meteor_size(rectangle_t *meteor, materials_table_t *materials)
+static void set_meteor_size(scene_t *scene, ID_t meteor, const materials_table_t *materials, random_t *random)
 {
-    const int SIZES_COUNT = 2;
-    int probabilities[SIZES_COUNT];
-    probabilities[0] = materials->materials[get_index_based_on_material_type((material_type_t)get_colour(meteor))].prob_size_1_px_t;
-    probabilities[1] = materials->materials[get_index_based_on_material_type((material_type_t)get_colour(meteor))].prob_size_2_px_t;
-    
-    int size_index = compute_cumulative_distribution(probabilities, SIZES_COUNT);
+    const material_row_t *material = &materials->materials[get_index_based_on_material_type((material_type_t)get_colour(scene, meteor))];
+    int size_index = sample_percent_table(&material->size_table, random);
 
     int width, height;
     switch (size_index)
@@ -517,50 +570,49 @@ static void set_meteor_size(rectangle_t *meteor, materials_table_t *materials)
         break;
     }
 
-    set_rectangle_width(meteor, width);
-    set_rectangle_height(meteor, height);
+    set_rectangle_width(scene, meteor, width);
+    set_rectangle_height(scene, meteor, height);
 }
 
 /**
  * Swaps the sides of a meteor with a given probability 50%.
  *
- * @param meteor A pointer to the meteor whose sides may be swapped.
+ * @param scene The scene holding the objects.
+ * @param meteor The ID of the meteor whose sides may be swapped.
+ * @param random The random number generator of the game.
  */
-static void swap_sides(rectangle_t *meteor)
+static void swap_sides(scene_t *scene, ID_t meteor, random_t *random)
 {
-    int probabilities[2] = { 50, 50 };
-    int index = compute_cumulative_distribution(probabilities, 2);
+    const int SWAP_PERCENT = 50;
 
-    if (index == 0) {
-        int lengt_1 = get_rectangle_width(meteor);
-        set_rectangle_width(meteor, get_rectangle_height(meteor));
-        set_rectangle_height(meteor, lengt_1);
+    if (random_below(random, PERCENT_TABLE_SIZE) < SWAP_PERCENT) {
+        int lengt_1 = get_rectangle_width(scene, meteor);
+        set_rectangle_width(scene, meteor, get_rectangle_height(scene, meteor));
+        set_rectangle_height(scene, meteor, lengt_1);
     }
 }
 
 /**
  * @brief Sets the shape of a meteor object based on material probabilities and current size.
  *
- * This function calculates the shape of a meteor object based on the provided materials' probabilities
- * and the current size of the meteor.
+ * This function draws the shape of a meteor object from the precomputed distribution of the shapes of its material
+ * and adjusts the current size of the meteor to the shape.
  *
- * @param meteor Pointer to the rectangle_t structure representing the meteor object.
+ * @param scene The scene holding the objects.
+ * @param meteor The ID of the meteor object.
  * @param materials Pointer to the materials_table_t structure containing material probabilities.
+ * @param random The random number generator of the game.
  */
-static void set_meteor_shape(rectangle_t *meteor, materials_table_t *materials)
+static void set_meteor_shape(scene_t *scene, ID_t meteor, const materials_table_t *materials, random_t *random)
 {
-    const int SHAPE_COUNT = 2;
-    int probabilities[SHAPE_COUNT];
-    probabilities[0] = materials->materials[get_index_based_on_material_type((material_type_t)get_colour(meteor))].prob_rectangle_shape;
-    probabilities[1] = materials->materials[get_index_based_on_material_type((material_type_t)get_colour(meteor))].prob_square_shape;
-
-    int size_index = compute_cumulative_distribution(probabilities, SHAPE_COUNT);
+    const material_row_t *material = &materials->materials[get_index_based_on_material_type((material_type_t)get_colour(scene, meteor))];
+    int size_index = sample_percent_table(&material->shape_table, random);
 
     switch (size_index)
     {
     case RECTANGLE:
-        set_rectangle_width(meteor, (get_rectangle_width(meteor) - 1 <= 0) ? 2 : (get_rectangle_width(meteor)));
-        swap_sides(meteor);
+        set_rectangle_width(scene, meteor, (get_rectangle_width(scene, meteor) - 1 <= 0) ? 2 : (get_rectangle_width(scene, meteor)));
+        swap_sides(scene, meteor, random);
         break;
     case SQUARE:
         break;
@@ -572,15 +624,15 @@ static void set_meteor_shape(rectangle_t *meteor, materials_table_t *materials)
 /**
  * @brief Determines the meteor material type based on the given level's probabilities.
  *
- * This function calculates the meteor material type based on the probabilities provided in the given level.
+ * This function draws the meteor material type from the precomputed distribution of the materials of the given level.
  *
- * @param level The level_row_t structure containing probabilities for different materials.
+ * @param level The level_row_t structure containing the distribution of the materials.
+ * @param random The random number generator of the game.
  * @return The material_type_t of the meteor material chosen based on probabilities.
  */
-static material_type_t count_meteor_material_from_level(level_row_t level)
+static material_type_t count_meteor_material_from_level(const level_row_t *level, random_t *random)
 {
-    int probabilities[MATERIALS_COUNT] = { level.prob_stone, level.prob_copper, level.prob_iron, level.prob_gold };
-    int material_index = compute_cumulative_distribution(probabilities, MATERIALS_COUNT);
+    int material_index = sample_percent_table(&level->material_table, random);
 
     return get_material_type_based_on_index(material_index);
 }
@@ -591,22 +643,27 @@ static material_type_t count_meteor_material_from_level(level_row_t level)
  * This function sets the properties of a meteor object, including its color, size, and shape, based on
  * the player's level, level data, and material data.
  *
- * @param meteor Pointer to the rectangle_t structure representing the meteor object.
+ * @param scene The scene holding the meteor.
+ * @param meteor The ID of the meteor object.
  * @param player_level The player's level.
  * @param levels Pointer to the levels_table_t structure containing level data.
  * @param materials Pointer to the materials_table_t structure containing material data.
+ * @param random The random number generator of the game.
  */
-static void set_meteor_properties(rectangle_t *meteor, int player_level, levels_table_t *levels, materials_table_t *materials, int width, int height)
+static void set_meteor_properties(scene_t *scene, ID_t meteor, int player_level, const levels_table_t *levels, const materials_table_t *materials, int width, int height, random_t *random)
 {
     if (player_level > levels->count - 1) {
         player_level = levels->count - 1;
     }
 
-    set_x_position(meteor, (rand() % (width - 21)) + 10);
-    set_y_position(meteor, (rand() % (height - 10)) + 5);
-    set_colour(meteor, (colour_t)count_meteor_material_from_level(levels->levels[player_level]));
-    set_meteor_size(meteor, materials);
-    set_meteor_shape(meteor, materials);
+    set_x_position(scene, meteor, random_below(random, width - 21) + 10);
+    set_y_position(scene, meteor, random_below(random, height - 10) + 5);
+    set_colour(scene, meteor, (colour_t)count_meteor_material_from_level(&levels->levels[player_level], random));
+    set_meteor_size(scene, meteor, materials, random);
+    set_meteor_shape(scene, meteor, materials, random);
+
+    // the meteor appears at the new place, it does not fly there
+    reset_object_interpolation(scene, meteor);
 }
 
 /**
@@ -622,31 +679,32 @@ static bool convert_line_into_material_data(materials_table_t *table, char *line
     const char* DELIMITER = ";";
 
     char* token;
+    char* save_pointer;
     char* line_copy = strdup(line);
     int prob_size_1_px_t; int prob_size_2_px_t; int prob_rectangle_shape; int prob_square_shape;
 
-    token = strtok(line_copy, DELIMITER);
+    token = strtok_r(line_copy, DELIMITER, &save_pointer);
     if (token == NULL || !convert_string_2_int(token, &prob_size_1_px_t)) {
         free(line_copy);
         resolve_error(INVALID_DATA_IN_FILE, file_path);
         return false;
     }
 
-    token = strtok(NULL, DELIMITER);
+    token = strtok_r(NULL, DELIMITER, &save_pointer);
     if (token == NULL || !convert_string_2_int(token, &prob_size_2_px_t)) {
         free(line_copy);
         resolve_error(INVALID_DATA_IN_FILE, file_path);
         return false;
     }
 
-    token = strtok(NULL, DELIMITER);
+    token = strtok_r(NULL, DELIMITER, &save_pointer);
     if (token == NULL || !convert_string_2_int(token, &prob_rectangle_shape)) {
         free(line_copy);
         resolve_error(INVALID_DATA_IN_FILE, file_path);
         return false;
     }
 
-    token = strtok(NULL, DELIMITER);
+    token = strtok_r(NULL, DELIMITER, &save_pointer);
     if (token == NULL || !convert_string_2_int(token, &prob_square_shape)) {
         free(line_copy);
         resolve_error(INVALID_DATA_IN_FILE, file_path);
@@ -654,7 +712,7 @@ static bool convert_line_into_material_data(materials_table_t *table, char *line
     }
 
     // check that line is completely read
-    if (strtok(NULL, DELIMITER) != NULL) {
+    if (strtok_r(NULL, DELIMITER, &save_pointer) != NULL) {
         free(line_copy);
         resolve_error(INVALID_DATA_IN_FILE, file_path);
         return false;
@@ -681,59 +739,60 @@ static bool convert_line_into_level_data(levels_table_t *table, char *line, cons
     const char* DELIMITER = ";";
 
     char* token;
+    char* save_pointer;
     char* line_copy = strdup(line);
     int stone_request; int copper_request; int iron_request; int gold_request; int prob_stone; int prob_copper; int prob_iron; int prob_gold;   
 
-    token = strtok(line_copy, DELIMITER);
+    token = strtok_r(line_copy, DELIMITER, &save_pointer);
     if (token == NULL || !convert_string_2_int(token, &stone_request)) {
         free(line_copy);
         resolve_error(INVALID_DATA_IN_FILE, file_path);
         return false;
     }
 
-    token = strtok(NULL, DELIMITER);
+    token = strtok_r(NULL, DELIMITER, &save_pointer);
     if (token == NULL || !convert_string_2_int(token, &copper_request)) {
         free(line_copy);
         resolve_error(INVALID_DATA_IN_FILE, file_path);
         return false;
     }
 
-    token = strtok(NULL, DELIMITER);
+    token = strtok_r(NULL, DELIMITER, &save_pointer);
     if (token == NULL || !convert_string_2_int(token, &iron_request)) {
         free(line_copy);
         resolve_error(INVALID_DATA_IN_FILE, file_path);
         return false;
     }
 
-    token = strtok(NULL, DELIMITER);
+    token = strtok_r(NULL, DELIMITER, &save_pointer);
     if (token == NULL || !convert_string_2_int(token, &gold_request)) {
         free(line_copy);
         resolve_error(INVALID_DATA_IN_FILE, file_path);
         return false;
     }
 
-    token = strtok(NULL, DELIMITER);
+    token = strtok_r(NULL, DELIMITER, &save_pointer);
     if (token == NULL || !convert_string_2_int(token, &prob_stone)) {
         free(line_copy);
         resolve_error(INVALID_DATA_IN_FILE, file_path);
         return false;
     }
 
-    token = strtok(NULL, DELIMITER);
+    token = strtok_r(NULL, DELIMITER, &save_pointer);
     if (token == NULL || !convert_string_2_int(token, &prob_copper)) {
         free(line_copy);
         resolve_error(INVALID_DATA_IN_FILE, file_path);
         return false;
     }
 
-    token = strtok(NULL, DELIMITER);
+    token = strtok_r(NULL, DELIMITER, &save_pointer);
     if (token == NULL || !convert_string_2_int(token, &prob_iron)) {
         free(line_copy);
         resolve_error(INVALID_DATA_IN_FILE, file_path);
         return false;
     }
 
-    token = strtok(NULL, DELIMITER);
+    token = strtok_r(NULL, DELIMITER, &save_pointer);
     if (token == NULL || !convert_string_2_int(token, &prob_gold)) {
         free(line_copy);
         resolve_error(INVALID_DATA_IN_FILE, file_path);
@@ -741,7 +800,7 @@ static bool convert_line_into_level_data(levels_table_t *table, char *line, cons
     }
 
     // check that line is completely read
-    if (strtok(NULL, DELIMITER) != NULL) {
+    if (strtok_r(NULL, DELIMITER, &save_pointer) != NULL) {
         free(line_copy);
         resolve_error(INVALID_DATA_IN_FILE, file_path);
         return false;
@@ -758,97 +817,145 @@ static bool convert_line_into_level_data(levels_table_t *table, char *line, cons
 }
 
 /**
- * @brief Moves the ball by updating its position based on its speed.
+ * @brief Moves the ball by the part of its speed which falls on one simulation step. The ball moves by whole pixels,
+ *        the rest of the distance is kept for the next steps.
  * 
- * @param ball The ball rectangle to move.
+ * @param game The game instance with a scene.
  */
-static void move_ball(rectangle_t *ball)
+static void move_ball(game_t *game)
 {
-    set_x_position(ball, get_x_position(ball) + get_x_speed(ball));
-    set_y_position(ball, get_y_position(ball) + get_y_speed(ball));
+    scene_t *scene = game->scene;
+    ID_t ball = game->actors.ball;
+
+    game->ball_remainder_x += (int64_t)get_x_speed(scene, ball) * game->step_duration;
+    game->ball_remainder_y += (int64_t)get_y_speed(scene, ball) * game->step_duration;
+
+    int x_movement = (int)(game->ball_remainder_x / GAME_SPEED_TIME_UNIT);
+    int y_movement = (int)(game->ball_remainder_y / GAME_SPEED_TIME_UNIT);
+    game->ball_remainder_x -= (int64_t)x_movement * GAME_SPEED_TIME_UNIT;
+    game->ball_remainder_y -= (int64_t)y_movement * GAME_SPEED_TIME_UNIT;
+
+    set_x_position(scene, ball, get_x_position(scene, ball) + x_movement);
+    set_y_position(scene, ball, get_y_position(scene, ball) + y_movement);
 }
 
 /**
  * @brief Bounces the ball off the game boundaries if it hits them.
  * 
+ * @param scene The scene holding the objects.
  * @param ball The ball rectangle to check and update.
  * @param width The width of the game area.
  * @param height The height of the game area.
  */
-static void bounce_ball(rectangle_t *ball, px_t width, px_t height)
+static void bounce_ball(scene_t *scene, ID_t ball, px_t width, px_t height)
 {
-    if(get_x_position(ball) >= width - 2 || get_x_position(ball) <= 0) {
-        set_x_speed(ball, get_x_speed(ball) * (-1));
-    }
-    if (get_y_position(ball) >= height - get_rectangle_height(ball) || get_y_position(ball) <= 0) {
-        set_y_speed(ball, get_y_speed(ball) * (-1));
+    // only a ball heading to the boundary bounces, with short steps it can stay at the boundary for a step after the bounce
+    int x_speed = get_x_speed(scene, ball);
+    if ((get_x_position(scene, ball) >= (int)width - 2 && x_speed > 0) || (get_x_position(scene, ball) <= 0 && x_speed < 0)) {
+        set_x_speed(scene, ball, x_speed * (-1));
+    }
+    int y_speed = get_y_speed(scene, ball);
+    if ((get_y_position(scene, ball) >= (int)height - get_rectangle_height(scene, ball) && y_speed > 0) || (get_y_position(scene, ball) <= 0 && y_speed < 0)) {
+        set_y_speed(scene, ball, y_speed * (-1));
     }     
 }
 
 /**
- * @brief Simulates the movement of the enemy paddle based on ball position.
+ * @brief Simulates the movement of a paddle controlled by the computer (the enemy, or the player in headless simulations)
+ *        based on the predicted crossing of the ball (see ai.h).
  * 
- * @param enemy The enemy paddle rectangle.
+ * @param scene The scene holding the objects.
+ * @param paddle The paddle rectangle.
  * @param ball The ball rectangle.
+ * @param controller The controller of the paddle.
+ * @param width The width of the game area.
  * @param height The height of the game area.
+ * @param random The random number generator of the game.
  */
-static void simulate_enemy_paddle_movement(rectangle_t *enemy, rectangle_t *ball, px_t height)
+static void simulate_ai_paddle_movement(scene_t *scene, ID_t paddle, ID_t ball, ai_controller_t *controller, px_t width, px_t height, random_t *random)
 {
-    int ball_center = get_y_position(ball) + (get_rectangle_height(ball) / 2);
-    int paddle_center = get_y_position(enemy) + (get_rectangle_height(enemy) / 2);
-    int paddle_speed = (abs(ball_center - paddle_center) < 9) ? 1 : 2;
-
-    if (ball_center < paddle_center) {
-        set_y_position(enemy, get_y_position(enemy) - paddle_speed);
-    } else if (ball_center > paddle_center) {
-        set_y_position(enemy, get_y_position(enemy) + paddle_speed);
-    }
-
-    set_y_position(enemy, get_y_position(enemy) + rand() % 3 - 1);
-
-    if (get_y_position(enemy) < 0) {
-        set_y_position(enemy, 0);
-    } else if (get_y_position(enemy) + get_rectangle_height(enemy) > height) {
-        set_y_position(enemy, height - get_rectangle_height(enemy));
-    }
+    ai_ball_t ball_state = {
+        .position_x = get_x_position(scene, ball),
+        .position_y = get_y_position(scene, ball),
+        .height = get_rectangle_height(scene, ball),
+        .x_speed = get_x_speed(scene, ball),
+        .y_speed = get_y_speed(scene, ball)
+    };
+    int paddle_center = get_y_position(scene, paddle) + (get_rectangle_height(scene, paddle) / 2);
+
+    int movement = compute_ai_paddle_movement(controller, &ball_state, get_x_position(scene, paddle), paddle_center, width, height, random);
+    int position = get_y_position(scene, paddle) + movement;
+
+    if (position < 0) {
+        position = 0;
+    } else if (position + get_rectangle_height(scene, paddle) > (int)height) {
+        position = height - get_rectangle_height(scene, paddle);
+    }
+    set_y_position(scene, paddle, position);
 }
 
 /**
- * @brief Detects if a collision with the specified collision ID occurred.
+ * @brief Detects if the object is among the collisions reported by the rasterizer.
  * 
- * @param collision_ID The collision ID to compare with.
- * @param object The rectangle object to check for collision.
+ * @param collisions The collisions to search.
+ * @param object The ID of the object to check for collision.
  * @return True if collision occurred, false otherwise.
  */
-static bool detect_collision(ID_t collision_ID, rectangle_t *object)
+static bool detect_collision(collisions_t *collisions, ID_t object)
 {
-    return collision_ID == get_ID(object);
+    return collisions_contain(collisions, object);
+}
+
+/**
+ * @brief Checks whether the ball has entered the columns of the paddle in this step. The ball bounces off a paddle only
+ *        when it enters its columns: with steps shorter than the time unit, the ball stays in the columns for several steps,
+ *        and a paddle must not bounce it again nor catch it later than it would with steps of one time unit.
+ * 
+ * @param scene The scene holding the objects.
+ * @param ball The ball rectangle.
+ * @param paddle The paddle rectangle.
+ * @return true if the ball was outside of the columns of the paddle before the step, false otherwise.
+ */
+static bool has_ball_entered_paddle_columns(scene_t *scene, ID_t ball, ID_t paddle)
+{
+    int ball_index = get_alive_object_index(scene, ball);
+    int paddle_index = get_alive_object_index(scene, paddle);
+    if (ball_index == -1 || paddle_index == -1) {
+        return false;
+    }
+
+    px_t previous_x = scene->previous_positions_x[ball_index];
+    px_t paddle_x = scene->positions_x[paddle_index];
+
+    return previous_x + scene->widths[ball_index] <= paddle_x || previous_x >= paddle_x + scene->widths[paddle_index];
 }
 
 /**
  * @brief Handles the collision between the ball and a paddle.
  * 
+ * @param scene The scene holding the objects.
  * @param ball The ball rectangle.
  * @param paddle The paddle rectangle.
  */
-static void handle_ball_and_paddle_collision(rectangle_t *ball, rectangle_t *paddle)
+static void handle_ball_and_paddle_collision(scene_t *scene, ID_t ball, ID_t paddle)
 {
-    int paddle_center = get_y_position(paddle) + (get_rectangle_height(paddle) / 2);
-    int ball_center = get_y_position(ball) + (get_rectangle_height(ball) / 2);
+    int paddle_center = get_y_position(scene, paddle) + (get_rectangle_height(scene, paddle) / 2);
+    int ball_center = get_y_position(scene, ball) + (get_rectangle_height(scene, ball) / 2);
     int vertical_distance = ball_center - paddle_center;
 
-    if (get_y_speed(ball) == 0) {
-        set_y_speed(ball, 1);
+    if (get_y_speed(scene, ball) == 0) {
+        set_y_speed(scene, ball, 1);
     }
     if (vertical_distance > 0) {
-        set_y_speed(ball, abs(get_y_speed(ball)));
+        set_y_speed(scene, ball, abs(get_y_speed(scene, ball)));
     } else if (vertical_distance < 0) {
-        set_y_speed(ball, -1 * abs(get_y_speed(ball)));
+        set_y_speed(scene, ball, -1 * abs(get_y_speed(scene, ball)));
     } else {
-        set_y_speed(ball, (rand() % 1) * (((rand() % 2) == 0) ? 1 : -1));
+        // a hit in the center of the paddle sends the ball straight back (no random numbers are drawn)
+        set_y_speed(scene, ball, 0);
     }
 
-    set_x_speed(ball, -1 * get_x_speed(ball));
+    set_x_speed(scene, ball, -1 * get_x_speed(scene, ball));
 }
 
 /**
@@ -859,12 +966,15 @@ static void handle_ball_and_paddle_collision(rectangle_t *ball, rectangle_t *pad
  * @param game The game instance.
  * @return True if the ball is within boundaries, false otherwise.
  */
-static bool check_ball_boundary_collision(rectangle_t *ball, game_t *game)
+static bool check_ball_boundary_collision(ID_t ball, game_t *game)
 {
+    scene_t *scene = game->scene;
+
     bool is_in_bound = true;
-    if (get_x_position(ball) <= 2) {
+    // the width is in pixels of two columns - the ball leaves before it could bounce off the right border
+    if (get_x_position(scene, ball) <= 2) {
         is_in_bound = false;
-    } else if (get_x_position(ball) + get_rectangle_width(ball) >= game->width) {
+    } else if (get_x_position(scene, ball) + 2 * get_rectangle_width(scene, ball) >= game->width) {
         is_in_bound = false;
     }
 
@@ -872,15 +982,17 @@ static bool check_ball_boundary_collision(rectangle_t *ball, game_t *game)
 
         if (get_game_ticks(game) % 2 == 0) {
             game->player->hearts--;
-            set_x_speed(ball, 2);
+            game->stats.player_hearts_lost++;
+            set_x_speed(scene, ball, 2);
         } else {
             game->enemy->hearts--;
-            set_x_speed(ball, -2);
+            game->stats.enemy_hearts_lost++;
+            set_x_speed(scene, ball, -2);
         }
 
         reset_game_ticks(game);
         set_objects_to_initial_position(game);
-        game->game_state = STOPPED;
+        stop_game(game);
     }
 
     return is_in_bound;
@@ -896,20 +1008,32 @@ static bool check_ball_boundary_collision(rectangle_t *ball, game_t *game)
  */
 static void set_objects_to_initial_position(game_t *game)
 {
-    rectangle_t *ball = find_object(game, "ball");
-    set_x_position(ball, BALL_INIT_X_COORD);
-    set_y_position(ball, BALL_INIT_Y_COORD);
-    set_y_speed(ball, 1);
-
-    rectangle_t *player = find_object(game, "player");
-    set_x_position(player, PLAYER_INIT_X_COORD);
-    set_y_position(player, PLAYER_INIT_Y_COORD);
-    set_y_speed(player, 0);
-
-    rectangle_t *enemy = find_object(game, "enemy");
-    set_x_position(enemy, ENEMY_INIT_X_COORD);
-    set_y_position(enemy, ENEMY_INIT_Y_COORD);
-    set_y_speed(enemy, 0);
+    scene_t *scene = game->scene;
+
+    ID_t ball = game->actors.ball;
+    set_x_position(scene, ball, BALL_INIT_X_COORD);
+    set_y_position(scene, ball, BALL_INIT_Y_COORD);
+    set_y_speed(scene, ball, 1);
+    game->ball_remainder_x = 0;
+    game->ball_remainder_y = 0;
+
+    ID_t player = game->actors.player_paddle;
+    set_x_position(scene, player, PLAYER_INIT_X_COORD);
+    set_y_position(scene, player, PLAYER_INIT_Y_COORD);
+    set_y_speed(scene, player, 0);
+
+    ID_t enemy = game->actors.enemy_paddle;
+    set_x_position(scene, enemy, ENEMY_INIT_X_COORD);
+    set_y_position(scene, enemy, ENEMY_INIT_Y_COORD);
+    set_y_speed(scene, enemy, 0);
+
+    // the ball has been teleported, so the predictions of its crossings are no longer valid
+    reset_ai_controller(&game->enemy_ai);
+    reset_ai_controller(&game->player_ai);
+
+    reset_object_interpolation(scene, ball);
+    reset_object_interpolation(scene, player);
+    reset_object_interpolation(scene, enemy);
 }
 
 /**
@@ -918,12 +1042,13 @@ static void set_objects_to_initial_position(game_t *game)
  * This function determines the shape of a meteor (square or rectangle) based on
  * its dimensions.
  *
- * @param meteor A pointer to the meteor whose shape is to be determined.
+ * @param scene The scene holding the objects.
+ * @param meteor The ID of the meteor whose shape is to be determined.
  * @return The shape of the meteor, either SQUARE or RECTANGLE.
  */
-static material_shape_t get_meteors_shape(rectangle_t *meteor)
+static material_shape_t get_meteors_shape(scene_t *scene, ID_t meteor)
 {
-    if (get_rectangle_width(meteor) == get_rectangle_height(meteor)) {
+    if (get_rectangle_width(scene, meteor) == get_rectangle_height(scene, meteor)) {
         return SQUARE;
     }
     return RECTANGLE;
@@ -936,24 +1061,26 @@ static material_shape_t get_meteors_shape(rectangle_t *meteor)
  * the specified meteor. The meteor's size and material type determine the
  * resource increments.
  *
- * @param meteor A pointer to the meteor whose properties are considered.
+ * @param scene The scene holding the objects.
+ * @param meteor The ID of the meteor whose properties are considered.
  * @param player A pointer to the player whose resources are updated.
+ * @return The amount of the resource added to the player.
  */
-static void update_player_resources(rectangle_t *meteor, player_t *player)
+static int update_player_resources(scene_t *scene, ID_t meteor, player_t *player)
 {
     int increment;
 
-    if (get_rectangle_width(meteor) == SMALL_METEOR_SIZE) {
+    if (get_rectangle_width(scene, meteor) == SMALL_METEOR_SIZE) {
         increment = 1;
     } else {
         increment = 3;
     }
 
-    if (get_meteors_shape(meteor) == SQUARE) {
+    if (get_meteors_shape(scene, meteor) == SQUARE) {
         increment++;
     }
 
-    switch (meteor->colour)
+    switch (get_colour(scene, meteor))
     {
     case STONE:
         player->stone += increment;
@@ -968,8 +1095,10 @@ static void update_player_resources(rectangle_t *meteor, player_t *player)
         player->gold += increment;
         break;
     default:
-        break;
+        return 0;
     }
+
+    return increment;
 }
 
 /**
@@ -978,34 +1107,18 @@ static void update_player_resources(rectangle_t *meteor, player_t *player)
  * @param meteor The meteor rectangle.
  * @param game The game instance.
  */
-static void handle_ball_and_meteor_collision(rectangle_t *meteor, game_t *game)
+static void handle_ball_and_meteor_collision(ID_t meteor, game_t *game)
 {
     if (get_game_ticks(game) % 2 != 0) {
-        update_player_resources(meteor, game->player);
+        int increment = update_player_resources(game->scene, meteor, game->player);
+        game->stats.resources_collected[get_index_based_on_material_type((material_type_t)get_colour(game->scene, meteor))] += increment;
     }
 
-    set_meteor_properties(meteor, game->player->level, game->levels_table, game->materials_table, get_width(game), get_height(game));
+    respawn_meteor(game, meteor);
     increment_game_ticks(game);
     reset_game_ticks(game);
 }
 
-/**
- * @brief Finds and returns the rectangle object with the specified name in the game scene.
- * 
- * @param game The game instance.
- * @param name The name of the rectangle object to find.
- * @return A pointer to the found rectangle object, or NULL if not found.
- */
-static rectangle_t *find_object(game_t *game, const char *name)
-{
-    for (int i = 0; i < game->scene->number_of_objects; ++i) {
-        if (STR_EQ(game->scene->scene[i]->name, name)) {
-            return game->scene->scene[i];
-        }
-    }
-    return NULL;
-}
-
 /**
  * @brief Creates a rectangle object, adds it to the scene, and checks for success.
  * 
@@ -1018,212 +1131,223 @@ static rectangle_t *find_object(game_t *game, const char *name)
  * @param y_speed The vertical speed of the rectangle.
  * @param colour The colour of the rectangle.
  * @param name The name of the rectangle object.
- * @return True if creation and addition were successful, false otherwise.
+ * @return The ID of the added object, or UNDEFINIED_ID on failure (the scene is released in that case).
  */
-static bool create_rectangle_and_add_it_to_scene(scene_t *scene, px_t position_x, px_t position_y, px_t width, px_t height, px_t x_speed, px_t y_speed, colour_t colour, const char *name)
+static ID_t create_rectangle_and_add_it_to_scene(scene_t *scene, px_t position_x, px_t position_y, px_t width, px_t height, px_t x_speed, px_t y_speed, colour_t colour, const char *name)
 {
-    rectangle_t *object = create_rectangle(position_x, position_y, width, height, x_speed, y_speed, colour, name);
-    if (object == NULL) {
-        resolve_error(MEM_ALOC_FAILURE, NULL);
-        return false;
-    }
-
-    if (add_to_scene(scene, object) == NULL) {
+    rectangle_t object = create_rectangle(position_x, position_y, width, height, x_speed, y_speed, colour, name);
+    ID_t ID = add_to_scene(scene, &object);
+    if (ID == UNDEFINIED_ID) {
         release_scene(scene);
         resolve_error(MEM_ALOC_FAILURE, NULL);
-        return false;
+        return UNDEFINIED_ID;
     }
 
-    return true;
-}
-
-/**
- * Tests the meteor generator by generating and logging meteor properties.
- *
- * This function generates meteor properties based on the specified tested level
- * and logs them to a file named "meteors_generator_output.log". The test is
- * performed for a total of 1000 meteor objects.
- *
- * @param tested_level The level for which meteor properties are tested.
- */
-static void test_meteors_generator(int tested_level)
-{
-    const char *TEST_FILE_NAME = "test_meteors_generator_output.log";
-    materials_table_t *materials = NULL;
-    levels_table_t *levels = NULL;
-    if (!load_extern_game_data(GAME_DATA_PATH, &materials, &levels)) {
-        return;
-    }
-
-    if (tested_level > levels->count - 1) {
-        tested_level = levels->count - 1;
-    }
-
-    if (access(TEST_FILE_NAME, F_OK) == 0) {
-        remove(TEST_FILE_NAME);
-    }
-
-    FILE *file = fopen(TEST_FILE_NAME, "a");
-    fprintf(file, "Tested level: %d.\n\n", tested_level);
-
-    for (int i = 0; i < 1000; ++i) {
-        rectangle_t *testing_meteor = create_rectangle(0, 0, 0, 0, 0, 0, WHITE, "testing meteor");
-        set_colour(testing_meteor, (colour_t)count_meteor_material_from_level(levels->levels[tested_level]));
-        set_meteor_size(testing_meteor, materials);
-        set_meteor_shape(testing_meteor, materials);
-        fprintf(file, "%.4d: %d %d %s\n", i + 1, get_rectangle_width(testing_meteor), get_rectangle_height(testing_meteor), colour_2_string(get_colour(testing_meteor)));
-        release_rectangle(testing_meteor);
-    }
-
-    fclose(file);
-
-    release_materials_table(materials);
-    release_levels_table(levels);
+    return ID;
 }
 
 // ------------------------------------------- GETTERS & SETTERS ------------------------------- //
 
 /**
- * @brief Gets the ID of the rectangle object.
+ * @brief Maps the ID of an object to its index in the dense arrays of the scene. A stale or unknown ID is reported as an error.
  * 
- * @param object The rectangle object.
- * @return The object's ID.
+ * @param scene The scene holding the objects.
+ * @param object The ID of the object.
+ * @return The index of the object, or -1 if the ID is not alive.
  */
-static ID_t get_ID(rectangle_t *object)
+static int get_alive_object_index(scene_t *scene, ID_t object)
 {
-    return object->ID;
+    int index = get_object_index(scene, object);
+    if (index == -1) {
+        resolve_error(GENERAL_ERROR, "access to an object with a stale ID.");
+    }
+    return index;
 }
 
 /**
  * @brief Sets the horizontal speed of the specified rectangle object.
  * 
- * @param object The rectangle object to modify.
+ * @param scene The scene holding the objects.
+ * @param object The ID of the object to modify.
  * @param speed The new horizontal speed to set.
  */
-static void set_x_speed(rectangle_t *object, int speed)
+static void set_x_speed(scene_t *scene, ID_t object, int speed)
 {
-    object->x_speed = speed;
+    int index = get_alive_object_index(scene, object);
+    if (index != -1) {
+        scene->x_speeds[index] = speed;
+    }
 }
 
 /**
  * @brief Retrieves the horizontal speed of the specified rectangle object.
  * 
- * @param object The rectangle object to query.
- * @return The horizontal speed of the object.
+ * @param scene The scene holding the objects.
+ * @param object The ID of the object to query.
+ * @return The horizontal speed of the object (0 if the ID is not alive).
  */
-static int get_x_speed(rectangle_t *object)
+static int get_x_speed(scene_t *scene, ID_t object)
 {
-    return object->x_speed;
+    int index = get_alive_object_index(scene, object);
+    if (index == -1) {
+        return 0;
+    }
+    return scene->x_speeds[index];
 }
 
 /**
  * @brief Sets the vertical speed of the specified rectangle object.
  * 
- * @param object The rectangle object to modify.
+ * @param scene The scene holding the objects.
+ * @param object The ID of the object to modify.
  * @param speed The new vertical speed to set.
  */
-static void set_y_speed(rectangle_t *object, int speed)
+static void set_y_speed(scene_t *scene, ID_t object, int speed)
 {
-    object->y_speed = speed;
+    int index = get_alive_object_index(scene, object);
+    if (index != -1) {
+        scene->y_speeds[index] = speed;
+    }
 }
 
 /**
  * @brief Retrieves the vertical speed of the specified rectangle object.
  * 
- * @param object The rectangle object to query.
- * @return The vertical speed of the object.
+ * @param scene The scene holding the objects.
+ * @param object The ID of the object to query.
+ * @return The vertical speed of the object (0 if the ID is not alive).
  */
-static int get_y_speed(rectangle_t *object)
+static int get_y_speed(scene_t *scene, ID_t object)
 {
-    return object->y_speed;
+    int index = get_alive_object_index(scene, object);
+    if (index == -1) {
+        return 0;
+    }
+    return scene->y_speeds[index];
 }
 
 /**
  * @brief Retrieves the x-coordinate position of the specified rectangle object.
  * 
- * @param object The rectangle object to query.
- * @return The x-coordinate position of the object.
+ * @param scene The scene holding the objects.
+ * @param object The ID of the object to query.
+ * @return The x-coordinate position of the object (0 if the ID is not alive).
  */
-static int get_x_position(rectangle_t *object)
+static int get_x_position(scene_t *scene, ID_t object)
 {
-    return object->position_x;
+    int index = get_alive_object_index(scene, object);
+    if (index == -1) {
+        return 0;
+    }
+    return scene->positions_x[index];
 }
 
 /**
  * @brief Sets the x-coordinate position of the specified rectangle object.
  * 
- * @param object The rectangle object to modify.
+ * @param scene The scene holding the objects.
+ * @param object The ID of the object to modify.
  * @param position The new x-coordinate position to set.
  */
-static void set_x_position(rectangle_t *object, px_t position)
+static void set_x_position(scene_t *scene, ID_t object, px_t position)
 {
-    object->position_x = position;
+    int index = get_alive_object_index(scene, object);
+    if (index != -1) {
+        scene->positions_x[index] = position;
+    }
 }
 
 /**
  * @brief Retrieves the y-coordinate position of the specified rectangle object.
  * 
- * @param object The rectangle object to query.
- * @return The y-coordinate position of the object.
+ * @param scene The scene holding the objects.
+ * @param object The ID of the object to query.
+ * @return The y-coordinate position of the object (0 if the ID is not alive).
  */
-static int get_y_position(rectangle_t *object)
+static int get_y_position(scene_t *scene, ID_t object)
 {
-    return object->position_y;
+    int index = get_alive_object_index(scene, object);
+    if (index == -1) {
+        return 0;
+    }
+    return scene->positions_y[index];
 }
 
 /**
  * @brief Sets the y-coordinate position of the specified rectangle object.
  * 
- * @param object The rectangle object to modify.
+ * @param scene The scene holding the objects.
+ * @param object The ID of the object to modify.
  * @param position The new y-coordinate position to set.
  */
-static void set_y_position(rectangle_t *object, px_t position)
+static void set_y_position(scene_t *scene, ID_t object, px_t position)
 {
-    object->position_y = position;
+    int index = get_alive_object_index(scene, object);
+    if (index != -1) {
+        scene->positions_y[index] = position;
+    }
 }
 
 /**
  * @brief Retrieves the length of the first side of the specified rectangle object.
  * 
- * @param object The rectangle object to query.
- * @return The length of the first side of the object.
+ * @param scene The scene holding the objects.
+ * @param object The ID of the object to query.
+ * @return The length of the first side of the object (0 if the ID is not alive).
  */
-static int get_rectangle_width(rectangle_t *object)
+static int get_rectangle_width(scene_t *scene, ID_t object)
 {
-    return object->width / 2;
+    int index = get_alive_object_index(scene, object);
+    if (index == -1) {
+        return 0;
+    }
+    return scene->widths[index] / 2;
 }
 
 /**
  * @brief Sets the value of the first side length of a rectangle object.
  * 
+ * @param scene The scene holding the objects.
  * @param object A pointer to the rectangle object whose first side length is to be set.
  * @param size The value to set as the first side length.
  */
-static void set_rectangle_width(rectangle_t *object, px_t size)
+static void set_rectangle_width(scene_t *scene, ID_t object, px_t size)
 {
-    object->width = size * 2;
+    int index = get_alive_object_index(scene, object);
+    if (index != -1) {
+        scene->widths[index] = size * 2;
+    }
 }
 
 /**
  * @brief Sets the value of the second side length of a rectangle object.
  *
+ * @param scene The scene holding the objects.
  * @param object A pointer to the rectangle object whose second side length is to be set.
  * @param size The value to set as the second side length.
  */
-static void set_rectangle_height(rectangle_t *object, px_t size)
+static void set_rectangle_height(scene_t *scene, ID_t object, px_t size)
 {
-    object->height = size;
+    int index = get_alive_object_index(scene, object);
+    if (index != -1) {
+        scene->heights[index] = size;
+    }
 }
 
 /**
  * @brief Retrieves the length of the second side of the specified rectangle object.
  * 
- * @param object The rectangle object to query.
- * @return The length of the second side of the object.
+ * @param scene The scene holding the objects.
+ * @param object The ID of the object to query.
+ * @return The length of the second side of the object (0 if the ID is not alive).
  */
-static int get_rectangle_height(rectangle_t *object)
+static int get_rectangle_height(scene_t *scene, ID_t object)
 {
-    return object->height;
+    int index = get_alive_object_index(scene, object);
+    if (index == -1) {
+        return 0;
+    }
+    return scene->heights[index];
 }
 
 /**
@@ -1250,41 +1374,51 @@ static void increment_game_ticks(game_t *game)
 /**
  * @brief Retrieves the colour of the specified rectangle object.
  * 
- * @param object The rectangle object to query.
+ * @param scene The scene holding the objects.
+ * @param object The ID of the object to query.
  * @return The colour of the object.
  */
-static colour_t get_colour(rectangle_t *object)
+static colour_t get_colour(scene_t *scene, ID_t object)
 {
-    return object->colour;
+    return get_object_colour(scene, object);
 }
 
 /**
  * @brief Sets the colour of the specified rectangle object.
  * 
- * @param object The rectangle object to modify.
+ * @param scene The scene holding the object (its palette is updated too), or NULL for an object outside of any scene.
+ * @param object The ID of the object to modify.
  * @param colour The new colour to set.
  */
-static void set_colour(rectangle_t *object, colour_t colour)
+static void set_colour(scene_t *scene, ID_t object, colour_t colour)
 {
-    object->colour = colour;
+    set_object_colour(scene, object, colour);
 }
 
 /**
  * @brief Retrieves a dynamically allocated copy of the name of the specified rectangle object.
  * 
- * @param object The rectangle object to query.
- * @return A pointer to the dynamically allocated name string.
+ * @param scene The scene holding the objects.
+ * @param object The ID of the object to query.
+ * @return A pointer to the dynamically allocated name string, or NULL on failure.
  * @note The returned pointer should be freed when no longer needed.
  */
-static char *get_name(rectangle_t *object)
+static char *get_name(scene_t *scene, ID_t object)
 {
-    char *name = malloc(strlen(object->name) + 1);
+    int index = get_alive_object_index(scene, object);
+    if (index == -1) {
+        return NULL;
+    }
+
+    const char *object_name = scene->names[index];
+    char *name = malloc(strlen(object_name) + 1);
     if (name == NULL) {
         resolve_error(MEM_ALOC_FAILURE, NULL);
         return NULL;
     }
 
-    strcpy(name, object->name);
+    strcpy(name, object_name);
+    return name;
 }
 
 /**
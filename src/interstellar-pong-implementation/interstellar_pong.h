@@ -15,12 +15,18 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include "../termify/clock.h"
 #include "../termify/draw.h"
+#include "../termify/input.h"
 #include "../termify/log.h"
+#include "../termify/random.h"
+#include "ai.h"
+#include "game_data.h"
 #include "levels.h"
 #include "materials.h"
 #include "../termify/page_loader.h"
 #include "player.h"
+#include "replay.h"
 #include "../termify/utils.h"
 
 /**
@@ -32,12 +38,73 @@ typedef enum game_state_t {
     TERMINATED /** The game has been terminated. In this state, the game has halted its main loop. */
 } game_state_t;
 
+/**
+ * @brief Number of meteors flying in the game at the same time.
+ */
+#define METEORS_COUNT 2
+
+/**
+ * @brief Time unit the speeds of the game are defined in: an object moves by its speed in pixels in one unit.
+ */
+#define GAME_SPEED_TIME_UNIT (70 * NANOSECONDS_IN_MILLISECOND)
+
+/**
+ * @brief Default duration of one simulation step of the game. With steps of one time unit, the objects move by whole speeds.
+ */
+#define DEFAULT_GAME_STEP_DURATION GAME_SPEED_TIME_UNIT
+
+/**
+ * @brief Shortest duration of one simulation step accepted by `set_game_step_duration()`.
+ */
+#define MIN_GAME_STEP_DURATION (1 * NANOSECONDS_IN_MILLISECOND)
+
+/**
+ * @brief Number of levels whose level-up times are recorded in the game statistics.
+ */
+#define MAX_TRACKED_LEVELS 16
+
+/**
+ * @brief Time the game stays STOPPED between two rounds (the objects wait at their initial positions).
+ */
+#define ROUND_COUNTDOWN_DURATION (20 * GAME_SPEED_TIME_UNIT)
+
+/**
+ * @brief Difficulty of the computer controlled paddles of a new game.
+ */
+#define DEFAULT_AI_DIFFICULTY AI_NORMAL
+
+/**
+ * @struct game_actors_t
+ * @brief Holds the IDs of the objects of the game scene, so the game never has to search for them by name.
+ */
+typedef struct game_actors_t {
+    ID_t ball;                     /** ID of the ball. */
+    ID_t player_paddle;            /** ID of the paddle controlled by the player. */
+    ID_t enemy_paddle;             /** ID of the paddle controlled by the enemy. */
+    ID_t meteors[METEORS_COUNT];   /** IDs of the meteors. */
+} game_actors_t;
+
+/**
+ * @struct game_stats_t
+ * @brief Statistics collected during one game. They are used for evaluating the balance of the game data.
+ */
+typedef struct game_stats_t {
+    long steps;                                   /** Number of simulation steps run (including the countdowns). */
+    int paddle_hits;                              /** Number of hits of the ball by both paddles. */
+    int player_hearts_lost;                       /** Number of hearts lost by the player. */
+    int enemy_hearts_lost;                        /** Number of hearts lost by the enemy. */
+    int resources_collected[MATERIALS_COUNT];     /** Amounts of the collected resources (STONE, COPPER, IRON, GOLD). */
+    int level_ups;                                /** Number of level-ups of the player. */
+    long level_up_steps[MAX_TRACKED_LEVELS];      /** Step of the game in which the player left the level given by the index (-1 if not left). */
+} game_stats_t;
+
 /**
  * @struct game_t
  * @brief Represents the game of Interstellar Pong. Holds general data about the current instance of the game.
  */
 typedef struct game_t {
     scene_t *scene;                       /** Pointer to the game scene. */
+    game_actors_t actors;                 /** IDs of the objects in the game scene. */
     player_t *player;                     /** Pointer to the player object. */
     player_t *player_choosen_to_game;     /** Pointer to the player object. This is the state of the player before the game - used for counting the resources collected in the game. */
     player_t *enemy;                      /** Pointer to the enemy object. */
@@ -45,8 +112,18 @@ typedef struct game_t {
     px_t height;                          /** Height of the game screen. */
     game_state_t game_state;              /** Current state of the game. */
     int game_ticks;                       /** Represents the number of ball bounces between players. */
-    materials_table_t *materials_table;   /** Pointer to the table containing data about materials. */
-    levels_table_t *levels_table;         /** Pointer to the table containing data about game levels. */
+    nanoseconds_t countdown_time;         /** Simulated time left until the STOPPED game runs again. */
+    nanoseconds_t step_duration;          /** Duration of one simulation step, the speeds are scaled by it (see GAME_SPEED_TIME_UNIT). */
+    int64_t ball_remainder_x;             /** Horizontal distance the ball has moved beyond its position, in pixels times nanoseconds. */
+    int64_t ball_remainder_y;             /** Vertical distance the ball has moved beyond its position, in pixels times nanoseconds. */
+    uint64_t seed;                        /** Seed of the random number generator of the game. */
+    random_t random;                      /** Random number generator of the game (every game has its own, so games can run in parallel). */
+    replay_t *replay;                     /** Recording of the keys of the game, or NULL if the game is not recorded. It is released with the game. */
+    bool is_player_ai;                    /** Whether the player's paddle is moved by the computer (used for headless simulations). */
+    ai_controller_t enemy_ai;             /** Controller of the enemy's paddle. */
+    ai_controller_t player_ai;            /** Controller of the player's paddle, used only if is_player_ai is set. */
+    game_stats_t stats;                   /** Statistics of the game. */
+    game_data_t *game_data;               /** Materials and levels tables of the game, shared with the other games (read-only). */
 } game_t;
 
 /**
@@ -55,9 +132,10 @@ typedef struct game_t {
  * @param player The player instance to use, or NULL to create a default player (game bound to no player account).
  * @param height The height of the game area.
  * @param width The width of the game area.
+ * @param seed The seed of the random number generator of the game. Games with the same seed and input run the same way.
  * @return A pointer to the newly created game instance, or NULL on failure.
  */
-game_t *init_game(player_t *player, px_t height, px_t width);
+game_t *init_game(player_t *player, px_t height, px_t width, uint64_t seed);
 
 /**
  * @brief Starts the game.
@@ -82,12 +160,33 @@ game_state_t get_game_state(game_t *game);
 void end_game(game_t *game);
 
 /**
- * @brief Stops the game.
+ * @brief Sets the duration of one simulation step. The speeds of the objects, the countdown between rounds and
+ *        the computer controlled paddles are scaled by it, so the game runs at the same pace at any step rate.
+ *        Steps shorter than GAME_SPEED_TIME_UNIT move the objects by parts of their speeds, so the collisions are
+ *        checked more often. It has to be called before the game starts.
+ * 
+ * @param game The game instance.
+ * @param step_duration The duration of one step, from MIN_GAME_STEP_DURATION to GAME_SPEED_TIME_UNIT.
+ * @return true on success, false if the duration is out of the range.
+ */
+bool set_game_step_duration(game_t *game, nanoseconds_t step_duration);
+
+/**
+ * @brief Stops the game for ROUND_COUNTDOWN_DURATION of simulated time. It is counted down by `update_scene()`,
+ *        which starts the game again once the countdown is over.
  * 
  * @param game The game instance to stop.
  */
 void stop_game(game_t *game);
 
+/**
+ * @brief Retrieves the simulated time left until the stopped game runs again.
+ * 
+ * @param game The game instance.
+ * @return The time left (0 if the game is not stopped).
+ */
+nanoseconds_t get_countdown_time(game_t *game);
+
 /**
  * @brief Releases memory occupied by the game instance and associated resources.
  * 
@@ -105,7 +204,18 @@ void release_game(game_t *game);
 scene_t *init_scene(game_t *game);
 
 /**
- * @brief Updates the game scene based on the current game state and updates pixels in <pixel_buffer>.
+ * @brief Places the meteor at a random position of the game area and draws its material (from the probabilities
+ *        of the player's level), size and shape (from the probabilities of the material).
+ * 
+ * @param game The game instance with a scene.
+ * @param meteor The ID of the meteor in the scene of the game.
+ */
+void respawn_meteor(game_t *game, ID_t meteor);
+
+/**
+ * @brief Runs one simulation step: updates the game scene based on the current game state and updates pixels in <pixel_buffer>.
+ *        If the game is STOPPED, the step only counts down the pause between rounds.
+ *        The positions of the objects before the step are saved, so the rendering can interpolate between them.
  * 
  * @param game The game instance to update.
  * @param pixel_buffer The pixel buffer to update with object pixels.
@@ -117,9 +227,17 @@ scene_t *update_scene(game_t *game, pixel_buffer_t *pixel_buffer);
  * @brief Handles the keyboard event and updates the game state accordingly.
  * 
  * @param game The game instance to update.
- * @param c The character representing the pressed key.
+ * @param key The pressed key (a character or one of the KEY_ARROW_* values).
+ */
+void handle_event(game_t *game, int key);
+
+/**
+ * @brief Checks whether the key moves the player's paddle.
+ * 
+ * @param key The pressed key (a character or one of the KEY_ARROW_* values).
+ * @return true for the movement keys, false otherwise.
  */
-void handle_event(game_t *game, char c);
+bool is_movement_key(int key);
 
 /**
  * @brief Loads external data from a file into materials and levels tables.
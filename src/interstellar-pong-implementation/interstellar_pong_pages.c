@@ -2,24 +2,42 @@
 #include <stdarg.h>
 #include <stdio.h>
 #include <stdlib.h>
-#include <sys/select.h>
 #include <time.h>
 #include <unistd.h>
 
 #include "interstellar_pong_pages.h"
 #include "paths.h"
+#include "../termify/clock.h"
+#include "../termify/event_loop.h"
 
 // ---------------------------------------- MACROS --------------------------------------------- //
 
 #define COMMAND_EQ(command, ch, CH, word, WORD) (STR_EQ(command, ch) || STR_EQ(command, CH) || STR_EQ(command, word) || STR_EQ(command, WORD))
 
+#define GAME_MAX_CATCH_UP_DURATION (5 * GAME_SPEED_TIME_UNIT)
+
+/**
+ * @struct game_session_t
+ * @brief Holds everything the event loop handlers of a running game need.
+ */
+typedef struct game_session_t {
+    game_t *game;                       /** The running game. */
+    pixel_buffer_t *collision_buffer;   /** Pixel buffer with the objects of the last simulation step. */
+    pixel_buffer_t *render_buffer;      /** Pixel buffer with the interpolated objects of the current frame. */
+    render_state_t *render_state;       /** What is shown on the canvas. */
+    frame_scheduler_t scheduler;        /** Scheduler of the simulation steps. */
+    input_buffer_t input;               /** Keys pressed and not processed yet. */
+    int pending_movement;               /** The latest movement key pressed during the countdown, it is applied once the round starts. */
+    frame_buffer_t *frame;              /** Frame buffer for the output of the frames. */
+} game_session_t;
+
 // ---------------------------------------- STATIC DECLARATIONS--------------------------------- //
 
 static page_return_code_t display_new_name_in_terminal(px_t width, page_loader_inner_data_t *data, terminal_data_t *terminal_data);
 static page_return_code_t handle_stats_for_no_player(px_t width, page_loader_inner_data_t *data, terminal_data_t *terminal_data);
 static void put_player(px_t width, px_t button_width, px_t button_height, player_t *player, bool last, px_t row_margin);
 static void check_and_set_player_name(const char *command, page_loader_inner_data_t *data);
-static void display_resources(player_t *player, levels_table_t *levels, int width);
+static void display_resources(player_t *player, const levels_table_t *levels, int width);
 static int update_players_stats(player_t *target_player, const char *file_path);
 static const char *create_resources_string(player_t *player, level_row_t level);
 static bool is_name_too_long(const char *name, page_loader_inner_data_t *data);
@@ -35,7 +53,8 @@ static const char *create_level_info_string(player_t *player);
 static players_array_t *load_players(const char* file_path);
 static void put_game_logo(px_t width, position_t position);
 static void display_live_stats(game_t *game);
-static int init_file_descriptor_monitor();
+static void handle_game_input(event_loop_t *loop, void *context);
+static void handle_game_frame(event_loop_t *loop, void *context);
 
 // ----------------------------------------- PROGRAM-------------------------------------------- //
 
@@ -410,11 +429,29 @@ page_return_code_t load_after_game_page(px_t height, px_t width, page_loader_inn
 
 page_return_code_t load_game(px_t height, px_t width, page_loader_inner_data_t *data)
 {
-    game_t *game = init_game(data->player_choosen_to_game, height, width);
+    // the seed is logged, so a reported game can be run again the same way
+    uint64_t seed = create_random_seed();
+    char seed_message[64];
+    snprintf(seed_message, sizeof(seed_message), "game started with seed %llu.", (unsigned long long)seed);
+    log_message(LOG_FILE_PATH, seed_message);
+
+    game_t *game = init_game(data->player_choosen_to_game, height, width, seed);
     if (game == NULL) {
         release_player(data->player_choosen_to_game);
         return ERROR;
     }
+    if (!set_game_step_duration(game, data->step_duration)) {
+        resolve_error(GENERAL_ERROR, "invalid duration of the simulation step.");
+        release_game(game);
+        release_player(data->player_choosen_to_game);
+        return ERROR;
+    }
+
+    // the game is recorded before its scene is created, because the scene already uses the random numbers
+    game->replay = create_replay(seed, height, width, game->step_duration, data->player_choosen_to_game);
+    if (game->replay == NULL) {
+        log_warning(LOG_FILE_PATH, "the game is not recorded, the replay could not be created.");
+    }
 
     scene_t *scene = init_scene(game);
     if (scene == NULL) {
@@ -422,61 +459,69 @@ page_return_code_t load_game(px_t height, px_t width, page_loader_inner_data_t *
         return ERROR;
     }
 
-    pixel_buffer_t *pixel_buffer1 = create_pixel_buffer(height, width);
-    if (pixel_buffer1 == NULL) {
+    // the collision buffer holds the objects of the last simulation step, the render buffer the interpolated ones
+    pixel_buffer_t *collision_buffer = create_pixel_buffer(height, width);
+    if (collision_buffer == NULL) {
         release_game(game);
-        release_scene(scene);
         release_player(data->player_choosen_to_game);
         return ERROR;
     }
 
-    pixel_buffer_t *pixel_buffer2 = create_pixel_buffer(height, width);
-    if (pixel_buffer2 == NULL) {
+    pixel_buffer_t *render_buffer = create_pixel_buffer(height, width);
+    if (render_buffer == NULL) {
         release_game(game);
-        release_scene(scene);
-        release_pixel_buffer(pixel_buffer1);
+        release_pixel_buffer(collision_buffer);
         release_player(data->player_choosen_to_game);
         return ERROR;
     }
 
-    clear_canvas();
-    start_game(game);
-
-    bool next_frame_stopped = false;
-    while (get_game_state(game) != TERMINATED) {
-
-        draw_borders(height + 1, width);
-        set_cursor_at_beginning_of_canvas();
-        reset_pixel_buffer(pixel_buffer2);
+    render_state_t *render_state = create_render_state(height, width);
+    if (render_state == NULL) {
+        release_game(game);
+        release_pixel_buffer(collision_buffer);
+        release_pixel_buffer(render_buffer);
+        release_player(data->player_choosen_to_game);
+        return ERROR;
+    }
 
-        if (init_file_descriptor_monitor() > 0) {
-            int c = getchar();
-            handle_event(game, c);
-        }
+    // the first column of the canvas lies on the left border
+    set_render_state_column_background(render_state, 0, "│");
 
-        update_scene(game, pixel_buffer2);
+    game_session_t session;
+    session.game = game;
+    session.collision_buffer = collision_buffer;
+    session.render_buffer = render_buffer;
+    session.render_state = render_state;
+    session.pending_movement = KEY_NONE;
+    session.frame = data->frame;
+    init_input_buffer(&session.input);
 
-        pixel_buffer_t *tmp_buffer = pixel_buffer1;
-        pixel_buffer1 = pixel_buffer2;
-        pixel_buffer2 = tmp_buffer;
-        render_graphics(pixel_buffer1, scene);
+    start_game(game);
+    // a loop which fell behind catches up with the same game time at any step rate
+    init_frame_scheduler(&session.scheduler, game->step_duration, data->frame_period, (int)(GAME_MAX_CATCH_UP_DURATION / game->step_duration));
 
-        display_live_stats(game);
-        usleep(70000);
+    // the game takes over the keyboard and renders a frame on every tick of its timer until it is terminated
+    int timer = add_timer_source(data->event_loop, data->frame_period, handle_game_frame, &session);
+    if (timer != -1 && add_event_source(data->event_loop, STDIN_FILENO, handle_game_input, &session)) {
+        (void)run_event_loop(data->event_loop);
+        remove_event_source(data->event_loop, STDIN_FILENO);
+    }
+    if (timer != -1) {
+        remove_timer_source(data->event_loop, timer);
+    }
 
-        if (next_frame_stopped) {
-            usleep(1350000);
-            next_frame_stopped = false;
-        }
+    // the loop also stops when the application is quitting (or when the event loop failed)
+    end_game(game);
 
-        if (get_game_state(game) == STOPPED) {
-            next_frame_stopped = true;
-            start_game(game);
-        }
+    // the replay of the last game is kept next to the logs, so it can be attached to bug reports
+    if (game->replay != NULL) {
+        finish_replay(game->replay, game);
+        (void)save_replay(game->replay, LAST_REPLAY_PATH);
     }
 
-    release_pixel_buffer(pixel_buffer1);
-    release_pixel_buffer(pixel_buffer2);
+    release_pixel_buffer(collision_buffer);
+    release_pixel_buffer(render_buffer);
+    release_render_state(render_state);
 
     if (update_players_stats(game->player, PLAYERS_DATA_PATH) == -1) {
         release_game(game);
@@ -963,12 +1008,13 @@ static page_return_code_t handle_stats_for_no_player(px_t width, page_loader_inn
  */
 static const char *create_level_info_string(player_t *player)
 {
-    levels_table_t *levels = NULL;
-    materials_table_t *materials = NULL;
-    if (!load_extern_game_data(GAME_DATA_PATH, &materials, &levels)) {
+    game_data_t *game_data = acquire_game_data(GAME_DATA_PATH, GAME_DATA_IMAGE_PATH);
+    if (game_data == NULL) {
         return NULL;
     }
 
+    const levels_table_t *levels = game_data->levels_table;
+
     char *level_info = NULL;
     if (player->level + 1 > levels->count - 1) {
         level_info = create_string("You have reached the maximum level! You are now the master of the interstellar space...");
@@ -984,29 +1030,11 @@ static const char *create_level_info_string(player_t *player)
                                                                                                                                      levels->levels[player->level].gold_request);
     }
 
-    release_levels_table(levels);
-    release_materials_table(materials);
+    release_game_data(game_data);
 
     return level_info;
 }
 
-/**
- * Initializes a file descriptor monitor for non-blocking input readiness check.
- * 
- * @return The result of the select function for checking input readiness.
- */
-static int init_file_descriptor_monitor()
-{
-    fd_set read_fds;
-    FD_ZERO(&read_fds);
-    FD_SET(STDIN_FILENO, &read_fds);
-
-    struct timeval timeout;
-    timeout.tv_sec = 0; timeout.tv_usec = 0;
-
-    return select(STDIN_FILENO + 1, &read_fds, NULL, NULL, &timeout);
-}
-
 /**
  * Updates the statistics of a target player in a specified file.
  * 
@@ -1163,7 +1191,7 @@ static const char *create_resources_string(player_t *player, level_row_t level)
  * @param levels The data about the game levels.
  * @param width The width of the display.
  */
-static void display_resources(player_t *player, levels_table_t *levels, int width)
+static void display_resources(player_t *player, const levels_table_t *levels, int width)
 {
     put_text("Resources:", width, CENTER);
 
@@ -1194,8 +1222,17 @@ static void display_live_stats(game_t *game)
     write_text("\n");
     display_hearts("Enemy", game->enemy->hearts);
     display_hearts("\t\t\t      Your", game->player->hearts);
+
+    // the rest of the line is cleared, so the countdown disappears once the round starts
+    write_text("\033[K");
+    if (get_game_state(game) == STOPPED) {
+        // rounded up to tenths of a second, so the last step does not show zero
+        const nanoseconds_t TENTH_OF_SECOND = 100 * NANOSECONDS_IN_MILLISECOND;
+        nanoseconds_t tenths = (get_countdown_time(game) + TENTH_OF_SECOND - 1) / TENTH_OF_SECOND;
+        write_text("\t  Next round in %d.%d s", (int)(tenths / 10), (int)(tenths % 10));
+    }
     write_text("\n");
-    display_resources(game->player, game->levels_table, game->width);
+    display_resources(game->player, game->game_data->levels_table, game->width);
 }
 
 /**
@@ -1213,3 +1250,82 @@ static void put_game_logo(px_t width, position_t position)
     put_text("|___|___|  /__|  \\___  >__| /_______  /|__|  \\___  >____/____(____  /__|     |____|   \\____/|___|  /\\___  / ", width, position);
     put_text("         \\/          \\/             \\/           \\/               \\/                             \\//_____/  ", width, position);
 }
+
+/**
+ * @brief Handler of the keyboard input of the game. The bytes are only collected here, they are processed
+ *        by the next frame. The game ends at the end of the input.
+ *
+ * @param loop The event loop.
+ * @param context The game session (game_session_t).
+ */
+static void handle_game_input(event_loop_t *loop, void *context)
+{
+    game_session_t *session = context;
+
+    if (drain_input(&session->input, STDIN_FILENO) == -1) {
+        end_game(session->game);
+        stop_event_loop(loop);
+    }
+}
+
+/**
+ * @brief Handler of the frame timer of the game. It processes the collected keys, runs the due simulation steps
+ *        and renders one frame. The run of the event loop is stopped once the game is terminated.
+ *
+ * @param loop The event loop.
+ * @param context The game session (game_session_t).
+ */
+static void handle_game_frame(event_loop_t *loop, void *context)
+{
+    game_session_t *session = context;
+    game_t *game = session->game;
+
+    int steps = start_scheduled_frame(&session->scheduler);
+
+    begin_frame(session->frame);
+
+    // the borders are drawn only if the canvas has to be painted from scratch (first frame or terminal resize)
+    if (render_state_needs_full_repaint(session->render_state)) {
+        clear_canvas();
+        draw_borders(game->height + 1, game->width);
+    }
+
+    // only the latest movement key of the frame moves the paddle
+    int movement = KEY_NONE;
+    for (int key = read_key(&session->input); key != KEY_NONE; key = read_key(&session->input)) {
+        if (is_movement_key(key)) {
+            movement = key;
+        } else {
+            handle_event(game, key);
+        }
+    }
+
+    if (movement != KEY_NONE && get_game_state(game) == STOPPED) {
+        session->pending_movement = movement;
+    } else if (movement != KEY_NONE && get_game_state(game) == RUNNING) {
+        handle_event(game, movement);
+    }
+
+    // the simulation runs at its own rate - there may be several steps or none before this frame
+    for (int i = 0; i < steps && get_game_state(game) != TERMINATED; ++i) {
+        bool was_stopped = get_game_state(game) == STOPPED;
+
+        reset_pixel_buffer(session->collision_buffer);
+        update_scene(game, session->collision_buffer);
+
+        if (was_stopped && get_game_state(game) == RUNNING && session->pending_movement != KEY_NONE) {
+            handle_event(game, session->pending_movement);
+            session->pending_movement = KEY_NONE;
+        }
+    }
+
+    compute_interpolated_scene_pixels_in_buffer(session->render_buffer, game->scene, get_interpolation_factor(&session->scheduler));
+    render_graphics(session->render_buffer, game->scene, session->render_state);
+
+    display_live_stats(game);
+    (void)end_frame();
+
+    if (get_game_state(game) == TERMINATED) {
+        stop_event_loop(loop);
+    }
+}
@@ -18,6 +18,14 @@
 
 #define GAME_WIDTH 80
 
+/**
+ * @brief Period of the frames of a game. The frames only show the simulation, so a longer period caps
+ *        the output (e.g. on remote terminals) without changing how the game plays.
+ */
+#define DEFAULT_GAME_FRAME_PERIOD (35 * NANOSECONDS_IN_MILLISECOND)
+#define MIN_GAME_FRAME_PERIOD (5 * NANOSECONDS_IN_MILLISECOND)
+#define MAX_GAME_FRAME_PERIOD (1000 * NANOSECONDS_IN_MILLISECOND)
+
 /**
  * @brief Finds the next page for Interstellar Pong game based on the current page and command.
  *
@@ -6,7 +6,13 @@
 
 level_row_t create_level_row(int stone_request, int copper_request, int iron_request, int gold_request, int prob_stone, int prob_copper, int prob_iron, int prob_gold)
 {
-    level_row_t row = { stone_request, copper_request, iron_request, gold_request, prob_stone, prob_copper, prob_iron, prob_gold };
+    level_row_t row = { 0 };
+    row.stone_request = stone_request; row.copper_request = copper_request; row.iron_request = iron_request; row.gold_request = gold_request;
+    row.prob_stone = prob_stone; row.prob_copper = prob_copper; row.prob_iron = prob_iron; row.prob_gold = prob_gold;
+
+    const int material_probabilities[] = { prob_stone, prob_copper, prob_iron, prob_gold };
+    build_percent_table(&row.material_table, material_probabilities, sizeof(material_probabilities) / sizeof(material_probabilities[0]));
+
     return row;
 }
 
@@ -15,6 +15,8 @@
 #ifndef LEVELS_H
 #define LEVELS_H
 
+#include "../termify/random.h"
+
 /**
  * @brief Represents a row of level data containing resource requests and probabilities.
  */
@@ -27,6 +29,7 @@ typedef struct level_row_t {
     int prob_copper;        /** The probability of encountering copper resources in the level. */
     int prob_iron;          /** The probability of encountering iron resources in the level. */
     int prob_gold;          /** The probability of encountering gold resources in the level. */
+    percent_table_t material_table; /** Precomputed distribution of the materials of the meteors (ordered as STONE, COPPER, IRON, GOLD). */
 } level_row_t;
 
 /**
@@ -39,7 +42,8 @@ typedef struct levels_table_t {
 } levels_table_t;
 
 /**
- * @brief Creates a new level row with the specified parameters.
+ * @brief Creates a new level row with the specified parameters. The distribution of the materials is precomputed,
+ *        so the meteors are generated without summing the probabilities again.
  * 
  * @param stone_request The stone resource request for the level.
  * @param copper_request The copper resource request for the level.
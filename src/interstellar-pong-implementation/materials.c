@@ -6,7 +6,16 @@
 
 material_row_t create_material_row(material_type_t material, int probability_of_size_1_px_t, int probability_of_size_2_px_t, int probability_of_rectangle_shape, int probability_of_square_shape)
 {
-    material_row_t row = { material, probability_of_size_1_px_t, probability_of_size_2_px_t, probability_of_rectangle_shape, probability_of_square_shape };
+    material_row_t row = { 0 };
+    row.material_type = material;
+    row.prob_size_1_px_t = probability_of_size_1_px_t; row.prob_size_2_px_t = probability_of_size_2_px_t;
+    row.prob_rectangle_shape = probability_of_rectangle_shape; row.prob_square_shape = probability_of_square_shape;
+
+    const int size_probabilities[] = { probability_of_size_1_px_t, probability_of_size_2_px_t };
+    const int shape_probabilities[] = { probability_of_rectangle_shape, probability_of_square_shape };
+    build_percent_table(&row.size_table, size_probabilities, sizeof(size_probabilities) / sizeof(size_probabilities[0]));
+    build_percent_table(&row.shape_table, shape_probabilities, sizeof(shape_probabilities) / sizeof(shape_probabilities[0]));
+
     return row;
 }
 
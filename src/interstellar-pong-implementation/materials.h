@@ -13,6 +13,7 @@
 #define MATERIALS_H
 
 #include "../termify/draw.h"
+#include "../termify/random.h"
 
 #define MATERIALS_COUNT 4
 
@@ -45,6 +46,8 @@ typedef struct material_row_t {
     int prob_size_2_px_t;       /** Probability of size 2 in pixels. */
     int prob_rectangle_shape;   /** Probability of rectangle shape. */
     int prob_square_shape;      /** Probability of square shape. */
+    percent_table_t size_table;     /** Precomputed distribution of the sizes (index 0 for 1 pixel, 1 for 2 pixels). */
+    percent_table_t shape_table;    /** Precomputed distribution of the shapes (indexed by material_shape_t). */
 } material_row_t;
 
 /**
@@ -58,7 +61,8 @@ typedef struct materials_table_t {
 } materials_table_t;
 
 /**
- * @brief Creates a material row with given probabilities.
+ * @brief Creates a material row with given probabilities. The distributions of the sizes and shapes are precomputed,
+ *        so the meteors are generated without summing the probabilities again.
  * 
  * @param probability_of_size_1_px_t Probability of size equal to 1 pixel.
  * @param probability_of_size_2_px_t Probability of size equal to 2 pixels.
@@ -14,5 +14,7 @@
 
 #define PLAYERS_DATA_PATH "res/players.data"
 #define GAME_DATA_PATH "res/game_data.ispdata"
+#define GAME_DATA_IMAGE_PATH "res/game_data.ispimg"
+#define LAST_REPLAY_PATH "logs/last_game.isprep"
 
 #endif
\ No newline at end of file
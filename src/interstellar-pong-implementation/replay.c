@@ -0,0 +1,509 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "interstellar_pong.h"
+#include "replay.h"
+#include "../termify/clock.h"
+#include "../termify/log.h"
+
+// ---------------------------------------- MACROS --------------------------------------------- //
+
+#define FNV_OFFSET_BASIS 2166136261U
+#define FNV_PRIME 16777619U
+
+#define VARINT_PAYLOAD_BITS 7
+#define VARINT_CONTINUATION_BIT 0x80
+#define MAX_VARINT_BYTES 10
+
+#define MAX_REPLAY_NAME_LENGTH 256
+
+// ---------------------------------- STATIC DECLARATIONS--------------------------------------- //
+
+static bool write_varint(FILE *file, uint64_t value);
+static bool write_signed_varint(FILE *file, int64_t value);
+static bool read_varint(FILE *file, uint64_t *value);
+static bool read_signed_varint(FILE *file, int64_t *value);
+static bool read_int(FILE *file, int *value);
+static bool write_player(FILE *file, const player_t *player);
+static player_t *read_player(FILE *file);
+static player_t *copy_player(const player_t *player);
+static uint32_t add_to_checksum(uint32_t checksum, int value);
+
+// ----------------------------------------- PROGRAM-------------------------------------------- //
+
+replay_t *create_replay(uint64_t seed, px_t height, px_t width, nanoseconds_t step_duration, const player_t *player)
+{
+    replay_t *replay = malloc(sizeof(replay_t));
+    if (replay == NULL) {
+        resolve_error(MEM_ALOC_FAILURE, NULL);
+        return NULL;
+    }
+
+    replay->seed = seed;
+    replay->height = height;
+    replay->width = width;
+    replay->step_duration = step_duration;
+    replay->events = NULL;
+    replay->events_count = 0;
+    replay->events_capacity = 0;
+    replay->steps = 0;
+    replay->checksum = 0;
+
+    replay->player = NULL;
+    if (player != NULL && (replay->player = copy_player(player)) == NULL) {
+        free(replay);
+        return NULL;
+    }
+
+    return replay;
+}
+
+bool record_replay_event(replay_t *replay, long step, int key)
+{
+    const int GROWTH_FACTOR = 2;
+    const int INITIAL_CAPACITY = 64;
+
+    if (replay->events_count == replay->events_capacity) {
+        int new_capacity = (replay->events_capacity == 0) ? INITIAL_CAPACITY : replay->events_capacity * GROWTH_FACTOR;
+        replay_event_t *new_events = realloc(replay->events, new_capacity * sizeof(replay_event_t));
+        if (new_events == NULL) {
+            resolve_error(MEM_ALOC_FAILURE, NULL);
+            return false;
+        }
+        replay->events = new_events;
+        replay->events_capacity = new_capacity;
+    }
+
+    replay->events[replay->events_count].step = step;
+    replay->events[replay->events_count].key = key;
+    replay->events_count++;
+
+    return true;
+}
+
+void finish_replay(replay_t *replay, const game_t *game)
+{
+    replay->steps = game->stats.steps;
+    replay->checksum = compute_game_checksum(game);
+}
+
+uint32_t compute_game_checksum(const game_t *game)
+{
+    const player_t *player = game->player;
+    const game_stats_t *stats = &game->stats;
+
+    // FNV-1a over the values which the game changes
+    uint32_t checksum = FNV_OFFSET_BASIS;
+    checksum = add_to_checksum(checksum, player->level);
+    checksum = add_to_checksum(checksum, player->stone);
+    checksum = add_to_checksum(checksum, player->copper);
+    checksum = add_to_checksum(checksum, player->iron);
+    checksum = add_to_checksum(checksum, player->gold);
+    checksum = add_to_checksum(checksum, player->hearts);
+    checksum = add_to_checksum(checksum, game->enemy->hearts);
+    checksum = add_to_checksum(checksum, stats->paddle_hits);
+    checksum = add_to_checksum(checksum, stats->player_hearts_lost);
+    checksum = add_to_checksum(checksum, stats->enemy_hearts_lost);
+    checksum = add_to_checksum(checksum, stats->level_ups);
+    for (int i = 0; i < MATERIALS_COUNT; ++i) {
+        checksum = add_to_checksum(checksum, stats->resources_collected[i]);
+    }
+
+    // the final positions differ even if a changed key did not change the score
+    const ID_t objects[] = { game->actors.ball, game->actors.player_paddle, game->actors.enemy_paddle };
+    for (size_t i = 0; i < sizeof(objects) / sizeof(objects[0]); ++i) {
+        int index = get_object_index(game->scene, objects[i]);
+        if (index == -1) {
+            // a missing actor is a difference of its own, it must not read outside of the scene arrays
+            checksum = add_to_checksum(checksum, -1);
+            continue;
+        }
+        checksum = add_to_checksum(checksum, (int)game->scene->positions_x[index]);
+        checksum = add_to_checksum(checksum, (int)game->scene->positions_y[index]);
+    }
+
+    return checksum;
+}
+
+bool save_replay(const replay_t *replay, const char *file_path)
+{
+    FILE *file = fopen(file_path, "wb");
+    if (file == NULL) {
+        resolve_error(UNOPENABLE_FILE, file_path);
+        return false;
+    }
+
+    bool is_written = fwrite(REPLAY_FILE_MAGIC, 1, strlen(REPLAY_FILE_MAGIC), file) == strlen(REPLAY_FILE_MAGIC)
+                      && write_varint(file, REPLAY_FILE_VERSION)
+                      && write_varint(file, replay->seed)
+                      && write_varint(file, replay->height)
+                      && write_varint(file, replay->width)
+                      && write_varint(file, (uint64_t)replay->step_duration)
+                      && write_player(file, replay->player)
+                      && write_signed_varint(file, replay->steps)
+                      && write_varint(file, replay->checksum)
+                      && write_varint(file, (uint64_t)replay->events_count);
+
+    // the steps only grow, so storing the difference from the previous key keeps the numbers small
+    long previous_step = 0;
+    for (int i = 0; is_written && i < replay->events_count; ++i) {
+        is_written = write_varint(file, (uint64_t)(replay->events[i].step - previous_step))
+                     && write_varint(file, (uint64_t)replay->events[i].key);
+        previous_step = replay->events[i].step;
+    }
+
+    if (fclose(file) != 0 || !is_written) {
+        resolve_error(CORRUPTED_WRITE_TO_FILE, file_path);
+        return false;
+    }
+
+    return true;
+}
+
+replay_t *load_replay(const char *file_path, uint64_t *version)
+{
+    *version = 0;
+
+    FILE *file = fopen(file_path, "rb");
+    if (file == NULL) {
+        resolve_error(UNOPENABLE_FILE, file_path);
+        return NULL;
+    }
+
+    char magic[sizeof(REPLAY_FILE_MAGIC)] = { 0 };
+    uint64_t seed, height, width, step_duration, checksum, events_count;
+    int64_t steps;
+    if (fread(magic, 1, strlen(REPLAY_FILE_MAGIC), file) != strlen(REPLAY_FILE_MAGIC) || strcmp(magic, REPLAY_FILE_MAGIC) != 0
+        || !read_varint(file, version)) {
+        fclose(file);
+        resolve_error(INVALID_DATA_IN_FILE, file_path);
+        return NULL;
+    }
+
+    if (*version != REPLAY_FILE_VERSION) {
+        fclose(file);
+        resolve_error(INVALID_DATA_IN_FILE, file_path);
+        return NULL;
+    }
+
+    if (!read_varint(file, &seed) || !read_varint(file, &height) || !read_varint(file, &width)
+        || !read_varint(file, &step_duration) || step_duration > INT64_MAX) {
+        fclose(file);
+        resolve_error(INVALID_DATA_IN_FILE, file_path);
+        return NULL;
+    }
+
+    // a missing player is stored as a zero flag, so NULL is valid here only if the flag was read
+    uint64_t has_player;
+    player_t *player = NULL;
+    if (!read_varint(file, &has_player) || (has_player && (player = read_player(file)) == NULL)) {
+        fclose(file);
+        resolve_error(INVALID_DATA_IN_FILE, file_path);
+        return NULL;
+    }
+
+    replay_t *replay = create_replay(seed, (px_t)height, (px_t)width, (nanoseconds_t)step_duration, player);
+    release_player(player);
+    if (replay == NULL) {
+        fclose(file);
+        return NULL;
+    }
+
+    bool is_valid = read_signed_varint(file, &steps) && read_varint(file, &checksum) && read_varint(file, &events_count);
+    replay->steps = (long)steps;
+    replay->checksum = (uint32_t)checksum;
+
+    long step = 0;
+    for (uint64_t i = 0; is_valid && i < events_count; ++i) {
+        uint64_t step_difference, key;
+        is_valid = read_varint(file, &step_difference) && read_varint(file, &key) && key <= INT32_MAX;
+        step += (long)step_difference;
+        is_valid = is_valid && record_replay_event(replay, step, (int)key);
+    }
+
+    fclose(file);
+
+    if (!is_valid) {
+        resolve_error(INVALID_DATA_IN_FILE, file_path);
+        release_replay(replay);
+        return NULL;
+    }
+
+    return replay;
+}
+
+bool play_replay(const replay_t *replay, bool *is_matching)
+{
+    player_t *player = NULL;
+    if (replay->player != NULL && (player = copy_player(replay->player)) == NULL) {
+        return false;
+    }
+
+    game_t *game = init_game(player, replay->height, replay->width, replay->seed);
+    if (game == NULL) {
+        release_player(player);
+        return false;
+    }
+
+    if (!set_game_step_duration(game, replay->step_duration)) {
+        resolve_error(INVALID_DATA_IN_FILE, "the replay has an invalid duration of the simulation step.");
+        release_game(game);
+        release_player(player);
+        return false;
+    }
+
+    pixel_buffer_t *collision_buffer = create_pixel_buffer(replay->height, replay->width);
+    if (init_scene(game) == NULL || collision_buffer == NULL) {
+        release_pixel_buffer(collision_buffer);
+        release_game(game);
+        release_player(player);
+        return false;
+    }
+
+    // the keys are passed in the same steps as in the recorded game, the rendering does not affect the simulation
+    start_game(game);
+    int event = 0;
+    while (true) {
+        while (event < replay->events_count && replay->events[event].step <= game->stats.steps) {
+            handle_event(game, replay->events[event].key);
+            event++;
+        }
+
+        if (get_game_state(game) == TERMINATED || game->stats.steps >= replay->steps) {
+            break;
+        }
+
+        reset_pixel_buffer(collision_buffer);
+        update_scene(game, collision_buffer);
+    }
+
+    *is_matching = event == replay->events_count && game->stats.steps == replay->steps
+                   && compute_game_checksum(game) == replay->checksum;
+
+    // the game releases its scene as well
+    release_pixel_buffer(collision_buffer);
+    release_game(game);
+    release_player(player);
+
+    return true;
+}
+
+int run_replay_playback(char *file_paths[], int files_count)
+{
+    int mismatches = 0;
+    long steps = 0;
+
+    nanoseconds_t start = get_monotonic_time();
+    for (int i = 0; i < files_count; ++i) {
+        uint64_t version;
+        replay_t *replay = load_replay(file_paths[i], &version);
+        bool is_matching = false;
+        if (replay == NULL && version != 0 && version != REPLAY_FILE_VERSION) {
+            printf("%s: the replay is refused, it was recorded by other rules of the game (version %llu, this game plays version %d)\n",
+                   file_paths[i], (unsigned long long)version, REPLAY_FILE_VERSION);
+            mismatches++;
+            continue;
+        }
+        if (replay == NULL || !play_replay(replay, &is_matching)) {
+            printf("%s: the replay could not be played\n", file_paths[i]);
+            release_replay(replay);
+            mismatches++;
+            continue;
+        }
+
+        printf("%s: seed %llu, %ld steps, %d keys: %s\n", file_paths[i], (unsigned long long)replay->seed,
+               replay->steps, replay->events_count, is_matching ? "matches" : "DOES NOT MATCH");
+        steps += replay->steps;
+        mismatches += is_matching ? 0 : 1;
+        release_replay(replay);
+    }
+    double seconds = (double)(get_monotonic_time() - start) / NANOSECONDS_IN_SECOND;
+
+    printf("%d replays (%ld steps) played in %.3f s, %d not matching\n", files_count, steps, seconds, mismatches);
+    return (mismatches == 0) ? 0 : -1;
+}
+
+void release_replay(replay_t *replay)
+{
+    if (replay != NULL) {
+        release_player(replay->player);
+        free(replay->events);
+        free(replay);
+    }
+}
+
+/**
+ * @brief Writes an unsigned number as a variable-length integer (7 bits per byte, the lowest bits first).
+ *
+ * @param file The file to write to.
+ * @param value The number.
+ * @return true on success, false on failure.
+ */
+static bool write_varint(FILE *file, uint64_t value)
+{
+    unsigned char bytes[MAX_VARINT_BYTES];
+    int count = 0;
+
+    do {
+        unsigned char byte = value & (VARINT_CONTINUATION_BIT - 1);
+        value >>= VARINT_PAYLOAD_BITS;
+        bytes[count++] = byte | ((value != 0) ? VARINT_CONTINUATION_BIT : 0);
+    } while (value != 0);
+
+    return fwrite(bytes, 1, count, file) == (size_t)count;
+}
+
+/**
+ * @brief Writes a signed number as a variable-length integer. The sign is moved to the lowest bit (zigzag
+ *        encoding), so numbers close to zero stay short.
+ *
+ * @param file The file to write to.
+ * @param value The number.
+ * @return true on success, false on failure.
+ */
+static bool write_signed_varint(FILE *file, int64_t value)
+{
+    return write_varint(file, ((uint64_t)value << 1) ^ (uint64_t)(value >> 63));
+}
+
+/**
+ * @brief Reads an unsigned number written by `write_varint()`.
+ *
+ * @param file The file to read from.
+ * @param value Placeholder for the number.
+ * @return true on success, false on failure or invalid data.
+ */
+static bool read_varint(FILE *file, uint64_t *value)
+{
+    *value = 0;
+
+    for (int i = 0; i < MAX_VARINT_BYTES; ++i) {
+        int byte = fgetc(file);
+        if (byte == EOF) {
+            return false;
+        }
+
+        *value |= (uint64_t)(byte & (VARINT_CONTINUATION_BIT - 1)) << (i * VARINT_PAYLOAD_BITS);
+        if ((byte & VARINT_CONTINUATION_BIT) == 0) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Reads a signed number written by `write_signed_varint()`.
+ *
+ * @param file The file to read from.
+ * @param value Placeholder for the number.
+ * @return true on success, false on failure or invalid data.
+ */
+static bool read_signed_varint(FILE *file, int64_t *value)
+{
+    uint64_t encoded;
+    if (!read_varint(file, &encoded)) {
+        return false;
+    }
+
+    *value = (int64_t)(encoded >> 1) ^ -(int64_t)(encoded & 1);
+    return true;
+}
+
+/**
+ * @brief Reads a signed number written by `write_signed_varint()` which has to fit into an int.
+ *
+ * @param file The file to read from.
+ * @param value Placeholder for the number.
+ * @return true on success, false on failure or invalid data.
+ */
+static bool read_int(FILE *file, int *value)
+{
+    int64_t wide_value;
+    if (!read_signed_varint(file, &wide_value) || wide_value < INT32_MIN || wide_value > INT32_MAX) {
+        return false;
+    }
+
+    *value = (int)wide_value;
+    return true;
+}
+
+/**
+ * @brief Writes a flag whether there is a player, followed by the name and the state of the player.
+ *
+ * @param file The file to write to.
+ * @param player The player, or NULL.
+ * @return true on success, false on failure.
+ */
+static bool write_player(FILE *file, const player_t *player)
+{
+    if (player == NULL) {
+        return write_varint(file, 0);
+    }
+
+    size_t name_length = strlen(player->name);
+    return write_varint(file, 1)
+           && write_varint(file, name_length) && fwrite(player->name, 1, name_length, file) == name_length
+           && write_signed_varint(file, player->level)
+           && write_signed_varint(file, player->stone) && write_signed_varint(file, player->copper)
+           && write_signed_varint(file, player->iron) && write_signed_varint(file, player->gold);
+}
+
+/**
+ * @brief Reads the name and the state of a player written by `write_player()` (the flag is read by the caller).
+ *
+ * @param file The file to read from.
+ * @return A pointer to the created player, or NULL on failure or invalid data.
+ */
+static player_t *read_player(FILE *file)
+{
+    uint64_t name_length;
+    if (!read_varint(file, &name_length) || name_length >= MAX_REPLAY_NAME_LENGTH) {
+        return NULL;
+    }
+
+    char name[MAX_REPLAY_NAME_LENGTH] = { 0 };
+    int level, stone, copper, iron, gold;
+    if (fread(name, 1, name_length, file) != name_length
+        || !read_int(file, &level) || !read_int(file, &stone) || !read_int(file, &copper)
+        || !read_int(file, &iron) || !read_int(file, &gold)) {
+        return NULL;
+    }
+
+    return create_player(name, level, stone, copper, iron, gold);
+}
+
+/**
+ * @brief Creates a copy of the player.
+ *
+ * @param player The player to copy.
+ * @return A pointer to the copy, or NULL on failure.
+ */
+static player_t *copy_player(const player_t *player)
+{
+    player_t *copy = create_player(player->name, player->level, player->stone, player->copper, player->iron, player->gold);
+    if (copy == NULL) {
+        resolve_error(MEM_ALOC_FAILURE, NULL);
+    }
+
+    return copy;
+}
+
+/**
+ * @brief Adds the bytes of the value to the FNV-1a checksum.
+ *
+ * @param checksum The checksum computed so far.
+ * @param value The value to add.
+ * @return The new checksum.
+ */
+static uint32_t add_to_checksum(uint32_t checksum, int value)
+{
+    uint32_t bits = (uint32_t)value;
+    for (int i = 0; i < 4; ++i) {
+        checksum ^= (bits >> (i * 8)) & 0xFF;
+        checksum *= FNV_PRIME;
+    }
+
+    return checksum;
+}
@@ -0,0 +1,155 @@
+/**
+ * @file replay.h
+ * @author Marek Eibel
+ * @brief Header file containing the recording and the playback of replays of InterStellar Pong.
+ *
+ * A game is fully given by its seed, the initial state of the player and the keys passed to `handle_event()`
+ * together with the simulation step in which they came, because the simulation itself is deterministic.
+ * The duration of the step is stored too, because the objects move by other distances in steps of other durations.
+ * A replay stores just that, plus the number of steps and a checksum of the final state of the player, of the
+ * statistics of the game and of the positions of the ball and the paddles (which differ as soon as the replayed
+ * game takes another course).
+ * The playback runs the simulation again as fast as possible (no rendering, no sleeping) and verifies that it
+ * ends in the same state, which makes replays usable both for reproducing reported bugs and for checking that
+ * a change of the physics or of the game data did not change the games.
+ *
+ * Replay files are compact: all the numbers are stored as variable-length integers and the steps of the keys
+ * are stored as differences from the previous key, so a key usually takes two or three bytes.
+ *
+ * @version 0.1
+ * @date 2023-10-04
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "player.h"
+#include "../termify/clock.h"
+#include "../termify/draw.h"
+
+#define REPLAY_FILE_MAGIC "ISPR"
+/**
+ * @brief Version of the replay files. It has to be bumped whenever the rules of the simulation change (the physics,
+ *        the computer controller, the generation of the meteors, ...), so that the older replays are refused
+ *        instead of being played by other rules and reported as not matching.
+ */
+#define REPLAY_FILE_VERSION 4
+
+struct game_t;
+
+/**
+ * @struct replay_event_t
+ * @brief Data structure representing a key passed to the game.
+ */
+typedef struct replay_event_t {
+    long step;    /** Number of the simulation steps run before the key came. */
+    int key;      /** The key. */
+} replay_event_t;
+
+/**
+ * @struct replay_t
+ * @brief Data structure representing a recorded game.
+ */
+typedef struct replay_t {
+    uint64_t seed;                  /** Seed of the game. */
+    px_t height;                    /** Height of the game area. */
+    px_t width;                     /** Width of the game area. */
+    nanoseconds_t step_duration;    /** Duration of one simulation step of the game (the keys are recorded in steps). */
+    player_t *player;               /** Copy of the player at the start of the game, or NULL for a game without a player account. */
+    replay_event_t *events;         /** Keys passed to the game in the order they came. */
+    int events_count;               /** Number of the keys. */
+    int events_capacity;            /** Capacity of the array of the keys. */
+    long steps;                     /** Number of the simulation steps of the whole game. */
+    uint32_t checksum;              /** Checksum of the game at the end (see `compute_game_checksum()`). */
+} replay_t;
+
+/**
+ * @brief Creates an empty replay of a game which is about to start.
+ *
+ * @param seed The seed of the game.
+ * @param height The height of the game area.
+ * @param width The width of the game area.
+ * @param step_duration The duration of one simulation step of the game.
+ * @param player The player of the game (it is copied), or NULL for a game without a player account.
+ * @return A pointer to the created replay, or NULL on failure.
+ */
+replay_t *create_replay(uint64_t seed, px_t height, px_t width, nanoseconds_t step_duration, const player_t *player);
+
+/**
+ * @brief Appends a key to the replay.
+ *
+ * @param replay The replay.
+ * @param step The number of the simulation steps run before the key came.
+ * @param key The key.
+ * @return true on success, false on failure.
+ */
+bool record_replay_event(replay_t *replay, long step, int key);
+
+/**
+ * @brief Stores the final state of the game into the replay.
+ *
+ * @param replay The replay.
+ * @param game The game at its end.
+ */
+void finish_replay(replay_t *replay, const struct game_t *game);
+
+/**
+ * @brief Computes the checksum of the state of the game: the level, resources and hearts of the player,
+ *        the hearts of the enemy, the statistics of the game and the positions of the ball and the paddles.
+ *
+ * @param game The game.
+ * @return The checksum.
+ */
+uint32_t compute_game_checksum(const struct game_t *game);
+
+/**
+ * @brief Saves the replay into a file.
+ *
+ * @param replay The replay.
+ * @param file_path The path of the file.
+ * @return true on success, false on failure.
+ */
+bool save_replay(const replay_t *replay, const char *file_path);
+
+/**
+ * @brief Loads a replay from a file.
+ *
+ * @param file_path The path of the file.
+ * @param version Placeholder for the version of the file, 0 if the file cannot be read or it is not a replay.
+ *                A replay of another version than REPLAY_FILE_VERSION is refused.
+ * @return A pointer to the loaded replay, or NULL on failure or if the replay is of another version.
+ */
+replay_t *load_replay(const char *file_path, uint64_t *version);
+
+/**
+ * @brief Runs the recorded game again without rendering and sleeping, and checks that it ends the same way.
+ *
+ * @param replay The replay.
+ * @param is_matching Placeholder set to true if the number of steps and the checksum of the game match the replay.
+ * @return true on success, false on failure (the game could not be created).
+ */
+bool play_replay(const replay_t *replay, bool *is_matching);
+
+/**
+ * @brief Plays the replays from the files and prints whether they match.
+ *
+ * @param file_paths The paths of the replay files.
+ * @param files_count The number of the files.
+ * @return 0 if all the replays match, -1 otherwise.
+ */
+int run_replay_playback(char *file_paths[], int files_count);
+
+/**
+ * @brief Releases the replay.
+ *
+ * @param replay The replay to release.
+ */
+void release_replay(replay_t *replay);
+
+#endif
@@ -0,0 +1,472 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "snapshot.h"
+
+// ---------------------------------------- MACROS --------------------------------------------- //
+
+#define MAX_SNAPSHOT_NAME_LENGTH 256
+
+// ---------------------------------- STATIC DECLARATIONS--------------------------------------- //
+
+static bool write_player_state(byte_buffer_t *buffer, const player_t *player);
+static bool read_player_state(byte_buffer_t *buffer, player_t *player, char **new_name);
+static void apply_player_state(player_t *player, const player_t *restored_player, char *new_name);
+static bool write_tables(byte_buffer_t *buffer, const materials_table_t *materials_table, const levels_table_t *levels_table);
+static bool read_tables(byte_buffer_t *buffer, game_data_t **game_data);
+static bool skip_table_rows(byte_buffer_t *buffer, size_t row_size, int *count, size_t *position);
+static bool read_snapshot_header(byte_buffer_t *buffer, px_t *height, px_t *width);
+static bool restore_game_state(game_t *game, byte_buffer_t *buffer, scene_t *scratch_scene);
+
+// ----------------------------------------- PROGRAM-------------------------------------------- //
+
+bool take_game_snapshot(game_t *game, byte_buffer_t *buffer)
+{
+    const uint32_t version = SNAPSHOT_VERSION;
+    const uint32_t game_size = sizeof(game_t);
+
+    clear_byte_buffer(buffer);
+
+    return write_bytes(buffer, SNAPSHOT_MAGIC, strlen(SNAPSHOT_MAGIC))
+           && write_value(buffer, version)
+           && write_value(buffer, game_size)
+           && write_value(buffer, game->height)
+           && write_value(buffer, game->width)
+           && write_value(buffer, game->game_state)
+           && write_value(buffer, game->game_ticks)
+           && write_value(buffer, game->countdown_time)
+           && write_value(buffer, game->step_duration)
+           && write_value(buffer, game->ball_remainder_x)
+           && write_value(buffer, game->ball_remainder_y)
+           && write_value(buffer, game->is_player_ai)
+           && write_value(buffer, game->enemy_ai)
+           && write_value(buffer, game->player_ai)
+           && write_value(buffer, game->seed)
+           && write_value(buffer, game->random)
+           && write_value(buffer, game->actors)
+           && write_value(buffer, game->stats)
+           && write_player_state(buffer, game->player)
+           && write_player_state(buffer, game->enemy)
+           && write_tables(buffer, game->game_data->materials_table, game->game_data->levels_table)
+           && write_scene(game->scene, buffer);
+}
+
+bool restore_game_snapshot(game_t *game, byte_buffer_t *buffer)
+{
+    scene_t *scratch_scene = create_scene();
+    if (scratch_scene == NULL) {
+        resolve_error(MEM_ALOC_FAILURE, NULL);
+        return false;
+    }
+
+    bool is_restored = restore_game_state(game, buffer, scratch_scene);
+
+    release_scene(scratch_scene);
+    return is_restored;
+}
+
+game_t *create_game_from_snapshot(byte_buffer_t *buffer, player_t *player_choosen_to_game)
+{
+    buffer->read_position = 0;
+
+    px_t height, width;
+    if (!read_snapshot_header(buffer, &height, &width)) {
+        resolve_error(INVALID_DATA_IN_FILE, "the snapshot of the game is corrupted.");
+        return NULL;
+    }
+
+    // the seed does not matter, the generator is overwritten by the snapshot
+    game_t *game = init_game(player_choosen_to_game, height, width, 0);
+    if (game == NULL) {
+        return NULL;
+    }
+
+    game->scene = create_scene();
+    if (game->scene == NULL) {
+        resolve_error(MEM_ALOC_FAILURE, NULL);
+        release_game(game);
+        return NULL;
+    }
+
+    if (!restore_game_snapshot(game, buffer)) {
+        release_game(game);
+        return NULL;
+    }
+
+    return game;
+}
+
+bool save_game_snapshot(game_t *game, const char *file_path)
+{
+    byte_buffer_t buffer;
+    init_byte_buffer(&buffer);
+
+    bool is_saved = take_game_snapshot(game, &buffer) && save_byte_buffer(&buffer, file_path);
+
+    release_byte_buffer(&buffer);
+    return is_saved;
+}
+
+game_t *load_game_snapshot(const char *file_path, player_t *player_choosen_to_game)
+{
+    byte_buffer_t buffer;
+    init_byte_buffer(&buffer);
+
+    game_t *game = NULL;
+    if (load_byte_buffer(&buffer, file_path)) {
+        game = create_game_from_snapshot(&buffer, player_choosen_to_game);
+    }
+
+    release_byte_buffer(&buffer);
+    return game;
+}
+
+rewind_buffer_t *create_rewind_buffer(int capacity, long interval)
+{
+    rewind_buffer_t *rewind_buffer = malloc(sizeof(rewind_buffer_t));
+    if (rewind_buffer == NULL) {
+        resolve_error(MEM_ALOC_FAILURE, NULL);
+        return NULL;
+    }
+
+    rewind_buffer->snapshots = malloc(sizeof(byte_buffer_t) * capacity);
+    rewind_buffer->scratch_scene = create_scene();
+    if (rewind_buffer->snapshots == NULL || rewind_buffer->scratch_scene == NULL) {
+        resolve_error(MEM_ALOC_FAILURE, NULL);
+        free(rewind_buffer->snapshots);
+        release_scene(rewind_buffer->scratch_scene);
+        free(rewind_buffer);
+        return NULL;
+    }
+
+    for (int i = 0; i < capacity; ++i) {
+        init_byte_buffer(&rewind_buffer->snapshots[i]);
+    }
+
+    rewind_buffer->capacity = capacity;
+    rewind_buffer->count = 0;
+    rewind_buffer->newest = capacity - 1;
+    rewind_buffer->interval = interval;
+
+    return rewind_buffer;
+}
+
+bool record_rewind_snapshot(rewind_buffer_t *rewind_buffer, game_t *game)
+{
+    if (game->stats.steps % rewind_buffer->interval != 0) {
+        return true;
+    }
+
+    int index = (rewind_buffer->newest + 1) % rewind_buffer->capacity;
+    if (!take_game_snapshot(game, &rewind_buffer->snapshots[index])) {
+        return false;
+    }
+
+    rewind_buffer->newest = index;
+    if (rewind_buffer->count < rewind_buffer->capacity) {
+        rewind_buffer->count++;
+    }
+
+    return true;
+}
+
+bool rewind_game(rewind_buffer_t *rewind_buffer, game_t *game, int snapshots_back)
+{
+    if (snapshots_back < 0 || snapshots_back >= rewind_buffer->count) {
+        return false;
+    }
+
+    int index = (rewind_buffer->newest - snapshots_back + rewind_buffer->capacity) % rewind_buffer->capacity;
+    if (!restore_game_state(game, &rewind_buffer->snapshots[index], rewind_buffer->scratch_scene)) {
+        return false;
+    }
+
+    // the restored snapshot becomes the newest one, the game will take the dropped ones again
+    rewind_buffer->newest = index;
+    rewind_buffer->count -= snapshots_back;
+
+    return true;
+}
+
+void release_rewind_buffer(rewind_buffer_t *rewind_buffer)
+{
+    if (rewind_buffer != NULL) {
+        for (int i = 0; i < rewind_buffer->capacity; ++i) {
+            release_byte_buffer(&rewind_buffer->snapshots[i]);
+        }
+        free(rewind_buffer->snapshots);
+        release_scene(rewind_buffer->scratch_scene);
+        free(rewind_buffer);
+    }
+}
+
+/**
+ * @brief Writes the name and the state of the player.
+ *
+ * @param buffer The buffer to write to.
+ * @param player The player.
+ * @return true on success, false on failure.
+ */
+static bool write_player_state(byte_buffer_t *buffer, const player_t *player)
+{
+    uint32_t name_length = (uint32_t)strlen(player->name);
+
+    return write_value(buffer, name_length)
+           && write_bytes(buffer, player->name, name_length)
+           && write_value(buffer, player->level)
+           && write_value(buffer, player->stone)
+           && write_value(buffer, player->copper)
+           && write_value(buffer, player->iron)
+           && write_value(buffer, player->gold)
+           && write_value(buffer, player->hearts);
+}
+
+/**
+ * @brief Reads the name and the state of the player written by `write_player_state()` into a copy of the player.
+ *        A new name is allocated only if it differs from the name of the copy.
+ *
+ * @param buffer The buffer to read from.
+ * @param player The copy of the player to read the state into (its name is not changed).
+ * @param new_name Placeholder for the allocated new name, or NULL if the name is the same.
+ * @return true on success, false on invalid data or failure (no name is allocated then).
+ */
+static bool read_player_state(byte_buffer_t *buffer, player_t *player, char **new_name)
+{
+    uint32_t name_length;
+    char name[MAX_SNAPSHOT_NAME_LENGTH] = { 0 };
+    *new_name = NULL;
+    if (!read_value(buffer, name_length) || name_length >= MAX_SNAPSHOT_NAME_LENGTH || !read_bytes(buffer, name, name_length)) {
+        return false;
+    }
+
+    bool is_read = read_value(buffer, player->level)
+                   && read_value(buffer, player->stone)
+                   && read_value(buffer, player->copper)
+                   && read_value(buffer, player->iron)
+                   && read_value(buffer, player->gold)
+                   && read_value(buffer, player->hearts);
+    if (!is_read || strcmp(player->name, name) == 0) {
+        return is_read;
+    }
+
+    *new_name = malloc(name_length + 1);
+    if (*new_name == NULL) {
+        resolve_error(MEM_ALOC_FAILURE, NULL);
+        return false;
+    }
+    strcpy(*new_name, name);
+
+    return true;
+}
+
+/**
+ * @brief Replaces the state of the player with the state read by `read_player_state()`. It cannot fail.
+ *
+ * @param player The player.
+ * @param restored_player The copy of the player with the read state.
+ * @param new_name The new name of the player (the player takes it over), or NULL to keep the name.
+ */
+static void apply_player_state(player_t *player, const player_t *restored_player, char *new_name)
+{
+    char *name = player->name;
+    if (new_name != NULL) {
+        free(name);
+        name = new_name;
+    }
+
+    *player = *restored_player;
+    player->name = name;
+}
+
+/**
+ * @brief Writes the rows of the materials and levels tables, each table preceded by the number of its rows.
+ *
+ * @param buffer The buffer to write to.
+ * @param materials_table The materials table.
+ * @param levels_table The levels table.
+ * @return true on success, false on failure.
+ */
+static bool write_tables(byte_buffer_t *buffer, const materials_table_t *materials_table, const levels_table_t *levels_table)
+{
+    return write_value(buffer, materials_table->count)
+           && write_bytes(buffer, materials_table->materials, sizeof(material_row_t) * materials_table->count)
+           && write_value(buffer, levels_table->count)
+           && write_bytes(buffer, levels_table->levels, sizeof(level_row_t) * levels_table->count);
+}
+
+/**
+ * @brief Reads the rows of the materials and levels tables written by `write_tables()`. The game keeps its data if the rows
+ *        are the same (the usual case, so restoring does not allocate), otherwise it gets its own data made of the rows.
+ *        The shared data is never modified, nor released (the caller releases the replaced data).
+ *
+ * @param buffer The buffer to read from.
+ * @param game_data The data of the game (it is replaced by new data if the rows differ).
+ * @return true on success, false on invalid data or failure.
+ */
+static bool read_tables(byte_buffer_t *buffer, game_data_t **game_data)
+{
+    int materials_count, levels_count;
+    size_t materials_position, levels_position;
+
+    if (!skip_table_rows(buffer, sizeof(material_row_t), &materials_count, &materials_position)
+        || !skip_table_rows(buffer, sizeof(level_row_t), &levels_count, &levels_position)) {
+        return false;
+    }
+
+    const game_data_t *current_data = *game_data;
+    if (materials_count == current_data->materials_table->count && levels_count == current_data->levels_table->count
+        && memcmp(buffer->data + materials_position, current_data->materials_table->materials, sizeof(material_row_t) * materials_count) == 0
+        && memcmp(buffer->data + levels_position, current_data->levels_table->levels, sizeof(level_row_t) * levels_count) == 0) {
+        return true;
+    }
+
+    materials_table_t *materials_table = create_materials_table();
+    levels_table_t *levels_table = create_levels_table();
+    if (materials_table == NULL || levels_table == NULL) {
+        resolve_error(MEM_ALOC_FAILURE, NULL);
+        release_materials_table(materials_table);
+        release_levels_table(levels_table);
+        return false;
+    }
+
+    for (int i = 0; i < materials_count; ++i) {
+        material_row_t material;
+        memcpy(&material, buffer->data + materials_position + sizeof(material_row_t) * i, sizeof(material_row_t));
+        if (add_material(materials_table, material) == NULL) {
+            release_materials_table(materials_table);
+            release_levels_table(levels_table);
+            return false;
+        }
+    }
+
+    for (int i = 0; i < levels_count; ++i) {
+        level_row_t level;
+        memcpy(&level, buffer->data + levels_position + sizeof(level_row_t) * i, sizeof(level_row_t));
+        if (add_level(levels_table, level) == NULL) {
+            release_materials_table(materials_table);
+            release_levels_table(levels_table);
+            return false;
+        }
+    }
+
+    game_data_t *restored_data = create_game_data(materials_table, levels_table);
+    if (restored_data == NULL) {
+        return false;
+    }
+
+    *game_data = restored_data;
+
+    return true;
+}
+
+/**
+ * @brief Reads the number of the rows of a table and skips the rows.
+ *
+ * @param buffer The buffer to read from.
+ * @param row_size The size of one row.
+ * @param count Placeholder for the number of the rows.
+ * @param position Placeholder for the position of the first row in the buffer.
+ * @return true on success, false if the rows are not in the buffer.
+ */
+static bool skip_table_rows(byte_buffer_t *buffer, size_t row_size, int *count, size_t *position)
+{
+    if (!read_value(buffer, *count) || *count < 0 || get_remaining_bytes(buffer) < row_size * *count) {
+        return false;
+    }
+
+    *position = buffer->read_position;
+    buffer->read_position += row_size * *count;
+
+    return true;
+}
+
+/**
+ * @brief Reads and checks the header of a snapshot.
+ *
+ * @param buffer The buffer to read from.
+ * @param height Placeholder for the height of the game area of the snapshot.
+ * @param width Placeholder for the width of the game area of the snapshot.
+ * @return true if the snapshot is of this version and of this build of the game, false otherwise.
+ */
+static bool read_snapshot_header(byte_buffer_t *buffer, px_t *height, px_t *width)
+{
+    char magic[sizeof(SNAPSHOT_MAGIC)] = { 0 };
+    uint32_t version, game_size;
+
+    return read_bytes(buffer, magic, strlen(SNAPSHOT_MAGIC)) && strcmp(magic, SNAPSHOT_MAGIC) == 0
+           && read_value(buffer, version) && version == SNAPSHOT_VERSION
+           && read_value(buffer, game_size) && game_size == sizeof(game_t)
+           && read_value(buffer, *height)
+           && read_value(buffer, *width);
+}
+
+/**
+ * @brief Restores the state of the game from a snapshot. The whole snapshot is read aside first (the scene into
+ *        the scratch scene), and the game is changed only once all of it has been read and checked.
+ *
+ * @param game The game.
+ * @param buffer The buffer with the snapshot (it is read from its beginning).
+ * @param scratch_scene An empty or unused scene to read the scene into. It is swapped with the scene of the game
+ *                      on success, so it holds the previous scene of the game afterwards.
+ * @return true on success, false on invalid data or failure (the game is not changed then).
+ */
+static bool restore_game_state(game_t *game, byte_buffer_t *buffer, scene_t *scratch_scene)
+{
+    buffer->read_position = 0;
+
+    px_t height, width;
+    if (!read_snapshot_header(buffer, &height, &width) || height != game->height || width != game->width) {
+        resolve_error(INVALID_DATA_IN_FILE, "the snapshot does not belong to the game.");
+        return false;
+    }
+
+    game_t restored_game = *game;
+    player_t restored_player = *game->player;
+    player_t restored_enemy = *game->enemy;
+    char *player_name = NULL;
+    char *enemy_name = NULL;
+
+    bool is_read = read_value(buffer, restored_game.game_state)
+                   && read_value(buffer, restored_game.game_ticks)
+                   && read_value(buffer, restored_game.countdown_time)
+                   && read_value(buffer, restored_game.step_duration)
+                   && read_value(buffer, restored_game.ball_remainder_x)
+                   && read_value(buffer, restored_game.ball_remainder_y)
+                   && read_value(buffer, restored_game.is_player_ai)
+                   && read_value(buffer, restored_game.enemy_ai)
+                   && read_value(buffer, restored_game.player_ai)
+                   && read_value(buffer, restored_game.seed)
+                   && read_value(buffer, restored_game.random)
+                   && read_value(buffer, restored_game.actors)
+                   && read_value(buffer, restored_game.stats)
+                   && read_player_state(buffer, &restored_player, &player_name)
+                   && read_player_state(buffer, &restored_enemy, &enemy_name)
+                   && read_tables(buffer, &restored_game.game_data)
+                   && read_scene(scratch_scene, buffer)
+                   && get_remaining_bytes(buffer) == 0;
+
+    if (!is_read) {
+        free(player_name);
+        free(enemy_name);
+        if (restored_game.game_data != game->game_data) {
+            release_game_data(restored_game.game_data);
+        }
+        resolve_error(INVALID_DATA_IN_FILE, "the snapshot of the game is corrupted.");
+        return false;
+    }
+
+    // nothing below can fail, so the game is never left half restored
+    if (restored_game.game_data != game->game_data) {
+        release_game_data(game->game_data);
+    }
+    apply_player_state(game->player, &restored_player, player_name);
+    apply_player_state(game->enemy, &restored_enemy, enemy_name);
+    *game = restored_game;
+
+    scene_t previous_scene = *game->scene;
+    *game->scene = *scratch_scene;
+    *scratch_scene = previous_scene;
+
+    return true;
+}
@@ -0,0 +1,137 @@
+/**
+ * @file snapshot.h
+ * @author Marek Eibel
+ * @brief Header file containing binary snapshots of running games of InterStellar Pong.
+ *
+ * A snapshot holds the whole state of a game: the state and the statistics of the game, its random number
+ * generator, the player and the enemy, the materials and levels tables and the scene. A game restored from
+ * a snapshot continues exactly as the game the snapshot was taken from (the simulation is deterministic).
+ * The state is copied as raw memory, so taking and restoring a snapshot takes a few microseconds. A snapshot is
+ * restored atomically: it is read and checked aside, and the game changes only if all of it is valid.
+ * Rewinding reads the scene into a scratch scene of the rewind buffer, so it does not allocate either. This makes snapshots usable for saving and resuming
+ * a session, for jumping to an interesting point of a game and for rewinding (see `rewind_buffer_t`).
+ * The tables are compared with the data the game shares (see `game_data_t`), which is never modified: a snapshot
+ * with other tables gives the game its own copy of them.
+ *
+ * The snapshot is stored in the native byte order and layout, so it is readable only by the same build
+ * of the game on the same machine. The header holds a version and the size of the game structure, so a
+ * snapshot of another build is refused instead of being misread.
+ * The recording of the game (`game_t.replay`) and the player chosen to the game are not part of the snapshot.
+ *
+ * @version 0.1
+ * @date 2023-10-05
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <stdbool.h>
+
+#include "interstellar_pong.h"
+#include "../termify/byte_buffer.h"
+
+#define SNAPSHOT_MAGIC "ISPS"
+#define SNAPSHOT_VERSION 2
+
+/**
+ * @struct rewind_buffer_t
+ * @brief Data structure representing a ring of the last snapshots of a game taken every few simulation steps.
+ *
+ * The buffers of the snapshots are reused, so recording the snapshots stops allocating once the ring is full.
+ */
+typedef struct rewind_buffer_t {
+    byte_buffer_t *snapshots;   /** The snapshots, the oldest one is overwritten when the ring is full. */
+    int capacity;               /** Number of the snapshots in the ring. */
+    int count;                  /** Number of the recorded snapshots. */
+    int newest;                 /** Index of the newest snapshot. */
+    long interval;              /** Number of simulation steps between two snapshots. */
+    scene_t *scratch_scene;     /** Scene the rewound scene is read into before it is swapped with the scene of the game. */
+} rewind_buffer_t;
+
+/**
+ * @brief Writes the snapshot of the game into the buffer (the previous content of the buffer is removed).
+ *
+ * @param game The game.
+ * @param buffer The buffer.
+ * @return true on success, false on failure.
+ */
+bool take_game_snapshot(game_t *game, byte_buffer_t *buffer);
+
+/**
+ * @brief Restores the state of the game from a snapshot. The snapshot has to be taken from a game of the same size.
+ *        The whole snapshot is read and checked before the game is touched, so a corrupted snapshot leaves
+ *        the game as it was.
+ *
+ * @param game The game.
+ * @param buffer The buffer with the snapshot (it is read from its beginning).
+ * @return true on success, false on invalid data or failure (the game is not changed then).
+ */
+bool restore_game_snapshot(game_t *game, byte_buffer_t *buffer);
+
+/**
+ * @brief Creates a new game from a snapshot.
+ *
+ * @param buffer The buffer with the snapshot (it is read from its beginning).
+ * @param player_choosen_to_game The player account of the game (see `game_t.player_choosen_to_game`), or NULL.
+ * @return A pointer to the created game with a scene, or NULL on failure or invalid data.
+ */
+game_t *create_game_from_snapshot(byte_buffer_t *buffer, player_t *player_choosen_to_game);
+
+/**
+ * @brief Saves the snapshot of the game into a file.
+ *
+ * @param game The game.
+ * @param file_path The path of the file.
+ * @return true on success, false on failure.
+ */
+bool save_game_snapshot(game_t *game, const char *file_path);
+
+/**
+ * @brief Creates a new game from a snapshot saved by `save_game_snapshot()`.
+ *
+ * @param file_path The path of the file.
+ * @param player_choosen_to_game The player account of the game (see `game_t.player_choosen_to_game`), or NULL.
+ * @return A pointer to the created game with a scene, or NULL on failure or invalid data.
+ */
+game_t *load_game_snapshot(const char *file_path, player_t *player_choosen_to_game);
+
+/**
+ * @brief Creates an empty rewind buffer.
+ *
+ * @param capacity The number of the snapshots kept.
+ * @param interval The number of simulation steps between two snapshots.
+ * @return A pointer to the created rewind buffer, or NULL on failure.
+ */
+rewind_buffer_t *create_rewind_buffer(int capacity, long interval);
+
+/**
+ * @brief Takes a snapshot of the game if a multiple of the interval of simulation steps has passed.
+ *        It is meant to be called after every simulation step.
+ *
+ * @param rewind_buffer The rewind buffer.
+ * @param game The game.
+ * @return true on success (also if no snapshot was due), false on failure.
+ */
+bool record_rewind_snapshot(rewind_buffer_t *rewind_buffer, game_t *game);
+
+/**
+ * @brief Restores the game from an older snapshot. The snapshots newer than the restored one are dropped.
+ *
+ * @param rewind_buffer The rewind buffer.
+ * @param game The game.
+ * @param snapshots_back The number of snapshots to go back (0 restores the newest one).
+ * @return true on success, false if there is no such snapshot or on failure (the game is not changed then).
+ */
+bool rewind_game(rewind_buffer_t *rewind_buffer, game_t *game, int snapshots_back);
+
+/**
+ * @brief Releases the rewind buffer and its snapshots.
+ *
+ * @param rewind_buffer The rewind buffer to release.
+ */
+void release_rewind_buffer(rewind_buffer_t *rewind_buffer);
+
+#endif
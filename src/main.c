@@ -15,22 +15,63 @@
  * @copyright Copyright (c) 2023
  */
 
+#include <signal.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <time.h>
 #include <unistd.h>
 
+#include "interstellar-pong-implementation/game_data.h"
+#include "interstellar-pong-implementation/headless.h"
+#include "interstellar-pong-implementation/interstellar_pong_pages.h"
+#include "interstellar-pong-implementation/paths.h"
 #include "termify/draw.h"
+#include "termify/event_loop.h"
+#include "termify/input.h"
 #include "termify/log.h"
 #include "termify/utils.h"
 #include "termify/page_loader.h"
 #include "termify/terminal.h"
+#include "termify/thread_pool.h"
 
 // ---------------------------------------- MACROS --------------------------------------------- //
 
 #define WINDOW_WIDTH 112
 #define WINDOW_HEIGHT 22
 
+#define PLAY_OPTION "--play"
+#define HEADLESS_OPTION "--headless"
+#define VERIFY_SNAPSHOTS_OPTION "--verify-snapshots"
+#define HEADLESS_DEFAULT_GAMES 100
+#define REPLAY_OPTION "--replay"
+#define COMPILE_DATA_OPTION "--compile-data"
+
+/**
+ * @struct application_t
+ * @brief Holds the state of the menus shared by the handlers of the event loop.
+ */
+typedef struct application_t {
+    terminal_data_t *terminal_data;                 /** Terminal for entering the commands. */
+    page_loader_inner_data_t *page_loader_data;     /** Data shared by the pages. */
+    page_t current_page;                            /** Currently shown page. */
+    input_buffer_t input;                           /** Bytes read from the keyboard and not processed yet. */
+} application_t;
+
+// ---------------------------------- STATIC DECLARATIONS--------------------------------------- //
+
+static int run_command_line_mode(int argc, char *argv[]);
+static bool parse_play_arguments(int argc, char *argv[], nanoseconds_t *step_duration, nanoseconds_t *frame_period);
+static bool convert_milliseconds_in_range(const char *string, nanoseconds_t min, nanoseconds_t max, nanoseconds_t *duration);
+static int run_headless_from_arguments(int argc, char *argv[]);
+static int run_data_compiler_from_arguments(int argc, char *argv[]);
+static void print_usage(const char *program_name);
+static void handle_menu_input(event_loop_t *loop, void *context);
+static bool process_menu_key(application_t *application, int key);
+static void handle_quit_signal(event_loop_t *loop, void *context);
+static void handle_resize_signal(event_loop_t *loop, void *context);
+
 // ----------------------------------------- PROGRAM-------------------------------------------- //
 
 /**
@@ -42,13 +83,40 @@
  * attributes are set correctly, and that the game environment is cleaned up
  * properly before exiting.
  *
+ * `--play [step ms] [frame ms]` runs the game with the given durations of the simulation step and of the frame
+ * (a longer frame caps the output on slow or remote terminals without changing how the game plays).
+ * With other command line arguments, the game runs without the terminal instead:
+ * `--headless [games] [seed] [threads] [difficulty] [step ms]` simulates games of the computer against the computer,
+ * `--verify-snapshots` with the same arguments simulates them and checks that restored snapshots end the same way,
+ * `--replay <files>` plays recorded games again and checks that they end the same way and
+ * `--compile-data [data file] [image]` compiles the game data file into the image loaded by the game.
+ *
+ * @param argc The number of the command line arguments.
+ * @param argv The command line arguments.
  * @return Returns EXIT_SUCCESS if the program runs successfully, or EXIT_FAILURE on errors.
  */
-int main() 
+int main(int argc, char *argv[])
 {   
+    nanoseconds_t step_duration = DEFAULT_GAME_STEP_DURATION;
+    nanoseconds_t frame_period = DEFAULT_GAME_FRAME_PERIOD;
+
+    if (argc > 1 && strcmp(argv[1], PLAY_OPTION) == 0) {
+        if (!parse_play_arguments(argc, argv, &step_duration, &frame_period)) {
+            print_usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    } else if (argc > 1) {
+        int exit_code = run_command_line_mode(argc, argv);
+        release_game_data_cache();
+        return exit_code;
+    }
+
     log_message(LOG_FILE_PATH, "application Interstellar-Pong has started.");
     hide_cursor();
 
+    // the game data is parsed before the first game, so starting a game does not read the file (a failure is reported again by the game)
+    release_game_data(acquire_game_data(GAME_DATA_PATH, GAME_DATA_IMAGE_PATH));
+
     // enable terminal
     terminal_data_t *terminal_data;
     if ((terminal_data = enable_terminal("Enter your commands.", TERMINAL_LOG, "Unknown command.", TERMINAL_WARNING)) == NULL) {
@@ -57,59 +125,58 @@ int main()
         return EXIT_FAILURE;
     }
 
+    // all the input, timers and signals of the application are handled by one event loop
+    event_loop_t *event_loop = create_event_loop();
+    if (event_loop == NULL) {
+        (void)close_terminal(terminal_data);
+        show_cursor();
+        return EXIT_FAILURE;
+    }
+
     // create data holder for page loader
-    page_loader_inner_data_t *page_loader_data = create_page_loader_inner_data();
+    page_loader_inner_data_t *page_loader_data = create_page_loader_inner_data(event_loop);
     if (page_loader_data == NULL) {
+        release_event_loop(event_loop);
         (void)close_terminal(terminal_data);
         show_cursor();
         return EXIT_FAILURE;
     }
+    page_loader_data->step_duration = step_duration;
+    page_loader_data->frame_period = frame_period;
 
     // try to load and render main page
     if (load_page(MAIN_PAGE, WINDOW_HEIGHT, WINDOW_WIDTH, page_loader_data, terminal_data) == ERROR) {
+        release_event_loop(event_loop);
         (void)close_terminal(terminal_data);
         release_page_loader_inner_data(page_loader_data);
         show_cursor();
         return EXIT_FAILURE;
     }
 
-    int c;
-    page_t current_page = MAIN_PAGE;
-
-    // program main loop
-    while ((c = getchar()) != EOF) {
-
-        char *command = NULL;
-        if (process_command(terminal_data, c, &command) == -1) {
-            free(command);
-            break;
-        }
-
-        page_t new_page = NO_PAGE;
-        page_loader_data->terminal_signal = false;
-        if (command != NULL) {
-            new_page = find_page(current_page, command, page_loader_data);
-            if (new_page != NO_PAGE) {
-                current_page = new_page;
-            } else {
-                page_loader_data->terminal_signal = true;
-            }
-        }
+    application_t application;
+    application.terminal_data = terminal_data;
+    application.page_loader_data = page_loader_data;
+    application.current_page = MAIN_PAGE;
+    init_input_buffer(&application.input);
 
-        free(command);
-        page_return_code_t load_page_return_code = load_page(current_page, WINDOW_HEIGHT, WINDOW_WIDTH, page_loader_data, terminal_data);
-
-        if (load_page_return_code == ERROR) {
-            break;
-        } else if (load_page_return_code == SUCCESS_GAME) {
-            current_page = AFTER_GAME_PAGE;
-            if (load_page(AFTER_GAME_PAGE, WINDOW_HEIGHT, WINDOW_WIDTH, page_loader_data, terminal_data) == ERROR) {
-                break;
-            } 
-        }
+    if (!add_event_source(event_loop, STDIN_FILENO, handle_menu_input, &application) ||
+        !add_signal_source(event_loop, SIGINT, handle_quit_signal, NULL) ||
+        !add_signal_source(event_loop, SIGTERM, handle_quit_signal, NULL) ||
+        !add_signal_source(event_loop, SIGWINCH, handle_resize_signal, NULL)) {
+        release_event_loop(event_loop);
+        (void)close_terminal(terminal_data);
+        release_page_loader_inner_data(page_loader_data);
+        show_cursor();
+        return EXIT_FAILURE;
     }
 
+    // program main loop
+    (void)run_event_loop(event_loop);
+
+    release_event_loop(event_loop);
     release_page_loader_inner_data(page_loader_data);
+    release_border_cache();
+    release_game_data_cache();
 
     if (close_terminal(terminal_data) == -1) {
         show_cursor();
@@ -123,3 +190,245 @@ int main()
 
     return EXIT_SUCCESS;
 }
+
+/**
+ * @brief Runs the mode selected by the command line arguments without the terminal.
+ *
+ * @param argc The number of the command line arguments.
+ * @param argv The command line arguments.
+ * @return EXIT_SUCCESS if the mode ran successfully, EXIT_FAILURE on errors or invalid arguments.
+ */
+static int run_command_line_mode(int argc, char *argv[])
+{
+    if (strcmp(argv[1], HEADLESS_OPTION) == 0 || strcmp(argv[1], VERIFY_SNAPSHOTS_OPTION) == 0) {
+        return run_headless_from_arguments(argc, argv);
+    }
+
+    if (strcmp(argv[1], REPLAY_OPTION) == 0 && argc > 2) {
+        return (run_replay_playback(&argv[2], argc - 2) == -1) ? EXIT_FAILURE : EXIT_SUCCESS;
+    }
+
+    if (strcmp(argv[1], COMPILE_DATA_OPTION) == 0) {
+        return run_data_compiler_from_arguments(argc, argv);
+    }
+
+    print_usage(argv[0]);
+    return EXIT_FAILURE;
+}
+
+/**
+ * @brief Runs the headless simulation with the command line arguments `--headless [games] [seed] [threads] [difficulty] [step ms]`.
+ *        Without a seed, the current time is used (it is printed, so the simulation can be repeated).
+ *        Without the number of threads, all the processor cores are used.
+ *        The difficulty of the enemy (easy, normal or hard) is DEFAULT_AI_DIFFICULTY if it is not given.
+ *        The duration of the simulation step in milliseconds is DEFAULT_GAME_STEP_DURATION if it is not given.
+ *        With `--verify-snapshots` instead of `--headless`, the snapshots of the games are verified as well.
+ *
+ * @param argc The number of the command line arguments.
+ * @param argv The command line arguments.
+ * @return EXIT_SUCCESS if the simulation ran successfully, EXIT_FAILURE on errors or invalid arguments.
+ */
+static int run_headless_from_arguments(int argc, char *argv[])
+{
+    int games_count = HEADLESS_DEFAULT_GAMES;
+    int seed = (int)time(NULL);
+    int threads_count = get_available_cores();
+    ai_difficulty_t enemy_difficulty = DEFAULT_AI_DIFFICULTY;
+    nanoseconds_t step_duration = DEFAULT_GAME_STEP_DURATION;
+    bool verify_snapshots = strcmp(argv[1], VERIFY_SNAPSHOTS_OPTION) == 0;
+
+    if (argc > 7
+        || (argc > 2 && (!convert_string_2_int(argv[2], &games_count) || games_count <= 0))
+        || (argc > 3 && !convert_string_2_int(argv[3], &seed))
+        || (argc > 4 && (!convert_string_2_int(argv[4], &threads_count) || threads_count <= 0))
+        || (argc > 5 && !convert_string_2_ai_difficulty(argv[5], &enemy_difficulty))
+        || (argc > 6 && !convert_milliseconds_in_range(argv[6], MIN_GAME_STEP_DURATION, GAME_SPEED_TIME_UNIT, &step_duration))) {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    printf("simulating %d games with seed %u on %d threads against the %s enemy, %d ms per step\n", games_count, (unsigned int)seed,
+           threads_count, ai_difficulty_2_string(enemy_difficulty), (int)(step_duration / NANOSECONDS_IN_MILLISECOND));
+    if (run_headless_simulation(games_count, (unsigned int)seed, threads_count, enemy_difficulty, step_duration, verify_snapshots) == -1) {
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Parses the command line arguments `--play [step ms] [frame ms]` of the interactive game.
+ *        The durations which are not given keep their values.
+ *
+ * @param argc The number of the command line arguments.
+ * @param argv The command line arguments.
+ * @param step_duration The duration of the simulation step, from MIN_GAME_STEP_DURATION to GAME_SPEED_TIME_UNIT.
+ * @param frame_period The period of the frames, from MIN_GAME_FRAME_PERIOD to MAX_GAME_FRAME_PERIOD.
+ * @return true if the arguments are valid, false otherwise.
+ */
+static bool parse_play_arguments(int argc, char *argv[], nanoseconds_t *step_duration, nanoseconds_t *frame_period)
+{
+    return argc <= 4
+           && (argc <= 2 || convert_milliseconds_in_range(argv[2], MIN_GAME_STEP_DURATION, GAME_SPEED_TIME_UNIT, step_duration))
+           && (argc <= 3 || convert_milliseconds_in_range(argv[3], MIN_GAME_FRAME_PERIOD, MAX_GAME_FRAME_PERIOD, frame_period));
+}
+
+/**
+ * @brief Converts a number of milliseconds given as a string into a duration and checks its range.
+ *
+ * @param string The number of milliseconds.
+ * @param min The shortest valid duration.
+ * @param max The longest valid duration.
+ * @param duration Placeholder for the duration (it is not changed if the string is invalid).
+ * @return true if the string is a number of milliseconds within the range, false otherwise.
+ */
+static bool convert_milliseconds_in_range(const char *string, nanoseconds_t min, nanoseconds_t max, nanoseconds_t *duration)
+{
+    int milliseconds;
+    if (!convert_string_2_int(string, &milliseconds)) {
+        return false;
+    }
+
+    nanoseconds_t converted = (nanoseconds_t)milliseconds * NANOSECONDS_IN_MILLISECOND;
+    if (converted < min || converted > max) {
+        return false;
+    }
+
+    *duration = converted;
+    return true;
+}
+
+/**
+ * @brief Compiles the game data file with the command line arguments `--compile-data [data file] [image]`.
+ *        The paths default to GAME_DATA_PATH and GAME_DATA_IMAGE_PATH, which the game loads.
+ *
+ * @param argc The number of the command line arguments.
+ * @param argv The command line arguments.
+ * @return EXIT_SUCCESS if the file was compiled, EXIT_FAILURE on errors or invalid arguments.
+ */
+static int run_data_compiler_from_arguments(int argc, char *argv[])
+{
+    if (argc > 4) {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    const char *file_path = (argc > 2) ? argv[2] : GAME_DATA_PATH;
+    const char *image_path = (argc > 3) ? argv[3] : GAME_DATA_IMAGE_PATH;
+
+    if (!compile_game_data(file_path, image_path)) {
+        fprintf(stderr, "%s could not be compiled (see the log for the details)\n", file_path);
+        return EXIT_FAILURE;
+    }
+
+    printf("%s compiled into %s\n", file_path, image_path);
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Prints the accepted command line arguments to the standard error output.
+ *
+ * @param program_name The name the program was started with.
+ */
+static void print_usage(const char *program_name)
+{
+    fprintf(stderr, "usage: %s [%s [step ms] [frame ms] | %s|%s [games] [seed] [threads] [easy|normal|hard] [step ms] | %s <files> | %s [data file] [image]]\n",
+            program_name, PLAY_OPTION, HEADLESS_OPTION, VERIFY_SNAPSHOTS_OPTION, REPLAY_OPTION, COMPILE_DATA_OPTION);
+}
+
+/**
+ * @brief Handler of the keyboard input of the menus. All the waiting bytes are read and processed as keys.
+ *        The event loop is quit at the end of the input, on errors and when the user leaves the application.
+ *
+ * @param loop The event loop.
+ * @param context The application (application_t).
+ */
+static void handle_menu_input(event_loop_t *loop, void *context)
+{
+    application_t *application = context;
+
+    if (drain_input(&application->input, STDIN_FILENO) == -1) {
+        quit_event_loop(loop);
+        return;
+    }
+
+    for (int key = read_key(&application->input); key != KEY_NONE; key = read_key(&application->input)) {
+        if (!process_menu_key(application, key) || is_event_loop_quitting(loop)) {
+            quit_event_loop(loop);
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Processes one key in the menus. When a command is completed, the page given by the command is loaded.
+ *
+ * @param application The application.
+ * @param key The pressed key.
+ * @return true if the application continues, false if it has to end.
+ */
+static bool process_menu_key(application_t *application, int key)
+{
+    page_loader_inner_data_t *page_loader_data = application->page_loader_data;
+
+    char *command = NULL;
+    if (process_command(application->terminal_data, key, &command) == -1) {
+        free(command);
+        return false;
+    }
+
+    page_t new_page = NO_PAGE;
+    page_loader_data->terminal_signal = false;
+    if (command != NULL) {
+        new_page = find_page(application->current_page, command, page_loader_data);
+        if (new_page != NO_PAGE) {
+            application->current_page = new_page;
+        } else {
+            page_loader_data->terminal_signal = true;
+        }
+    }
+
+    free(command);
+    page_return_code_t load_page_return_code = load_page(application->current_page, WINDOW_HEIGHT, WINDOW_WIDTH, page_loader_data, application->terminal_data);
+
+    if (load_page_return_code == ERROR) {
+        return false;
+    } else if (load_page_return_code == SUCCESS_GAME) {
+        // the game may have ended because the application is quitting, then there is nothing to show
+        if (is_event_loop_quitting(page_loader_data->event_loop)) {
+            return false;
+        }
+
+        application->current_page = AFTER_GAME_PAGE;
+        if (load_page(AFTER_GAME_PAGE, WINDOW_HEIGHT, WINDOW_WIDTH, page_loader_data, application->terminal_data) == ERROR) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Handler of SIGINT and SIGTERM. The application ends the same way as if the user quit it.
+ *
+ * @param loop The event loop.
+ * @param context Unused.
+ */
+static void handle_quit_signal(event_loop_t *loop, void *context)
+{
+    (void)context;
+    quit_event_loop(loop);
+}
+
+/**
+ * @brief Handler of SIGWINCH. The canvas of the game is repainted from scratch in the next frame.
+ *
+ * @param loop The event loop.
+ * @param context Unused.
+ */
+static void handle_resize_signal(event_loop_t *loop, void *context)
+{
+    (void)loop;
+    (void)context;
+    notify_terminal_resize();
+}
@@ -0,0 +1,141 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "byte_buffer.h"
+#include "log.h"
+
+// ---------------------------------- STATIC DECLARATIONS--------------------------------------- //
+
+static bool reserve_bytes(byte_buffer_t *buffer, size_t capacity);
+
+// ----------------------------------------- PROGRAM-------------------------------------------- //
+
+void init_byte_buffer(byte_buffer_t *buffer)
+{
+    buffer->data = NULL;
+    buffer->size = 0;
+    buffer->capacity = 0;
+    buffer->read_position = 0;
+}
+
+void clear_byte_buffer(byte_buffer_t *buffer)
+{
+    buffer->size = 0;
+    buffer->read_position = 0;
+}
+
+bool write_bytes(byte_buffer_t *buffer, const void *bytes, size_t count)
+{
+    const size_t GROWTH_FACTOR = 2;
+    const size_t BEGIN_CAPACITY = 256;
+
+    if (buffer->size + count > buffer->capacity) {
+        size_t capacity = (buffer->capacity == 0) ? BEGIN_CAPACITY : buffer->capacity;
+        while (capacity < buffer->size + count) {
+            capacity *= GROWTH_FACTOR;
+        }
+        if (!reserve_bytes(buffer, capacity)) {
+            return false;
+        }
+    }
+
+    memcpy(buffer->data + buffer->size, bytes, count);
+    buffer->size += count;
+
+    return true;
+}
+
+bool read_bytes(byte_buffer_t *buffer, void *bytes, size_t count)
+{
+    if (get_remaining_bytes(buffer) < count) {
+        return false;
+    }
+
+    memcpy(bytes, buffer->data + buffer->read_position, count);
+    buffer->read_position += count;
+
+    return true;
+}
+
+size_t get_remaining_bytes(const byte_buffer_t *buffer)
+{
+    return buffer->size - buffer->read_position;
+}
+
+bool save_byte_buffer(const byte_buffer_t *buffer, const char *file_path)
+{
+    FILE *file = fopen(file_path, "wb");
+    if (file == NULL) {
+        resolve_error(UNOPENABLE_FILE, file_path);
+        return false;
+    }
+
+    bool is_written = fwrite(buffer->data, 1, buffer->size, file) == buffer->size;
+    if (fclose(file) != 0 || !is_written) {
+        resolve_error(CORRUPTED_WRITE_TO_FILE, file_path);
+        return false;
+    }
+
+    return true;
+}
+
+bool load_byte_buffer(byte_buffer_t *buffer, const char *file_path)
+{
+    FILE *file = fopen(file_path, "rb");
+    if (file == NULL) {
+        resolve_error(UNOPENABLE_FILE, file_path);
+        return false;
+    }
+
+    long file_size;
+    if (fseek(file, 0, SEEK_END) != 0 || (file_size = ftell(file)) < 0 || fseek(file, 0, SEEK_SET) != 0) {
+        fclose(file);
+        resolve_error(GENERAL_IO_ERROR, file_path);
+        return false;
+    }
+
+    clear_byte_buffer(buffer);
+    if ((size_t)file_size > buffer->capacity && !reserve_bytes(buffer, (size_t)file_size)) {
+        fclose(file);
+        return false;
+    }
+
+    buffer->size = fread(buffer->data, 1, (size_t)file_size, file);
+    fclose(file);
+
+    if (buffer->size != (size_t)file_size) {
+        clear_byte_buffer(buffer);
+        resolve_error(GENERAL_IO_ERROR, file_path);
+        return false;
+    }
+
+    return true;
+}
+
+void release_byte_buffer(byte_buffer_t *buffer)
+{
+    free(buffer->data);
+    init_byte_buffer(buffer);
+}
+
+/**
+ * @brief Reallocates the bytes of the buffer to the given capacity.
+ *
+ * @param buffer The buffer.
+ * @param capacity The new capacity (it must not be lower than the size).
+ * @return true on success, false if the memory allocation failed (the buffer is untouched then).
+ */
+static bool reserve_bytes(byte_buffer_t *buffer, size_t capacity)
+{
+    unsigned char *data = realloc(buffer->data, capacity);
+    if (data == NULL) {
+        resolve_error(MEM_ALOC_FAILURE, NULL);
+        return false;
+    }
+
+    buffer->data = data;
+    buffer->capacity = capacity;
+
+    return true;
+}
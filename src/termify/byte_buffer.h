@@ -0,0 +1,112 @@
+/**
+ * @file byte_buffer.h
+ * @author Marek Eibel
+ * @brief Header file containing a growable buffer of bytes used for binary serialization.
+ *
+ * Values are appended with `write_bytes()` (or `write_value()`) and read back in the same order with `read_bytes()`
+ * (or `read_value()`). The values are stored in the native byte order and layout, so serialized data is meant to be
+ * read by the same build of the program (e.g. snapshots of a running game). Clearing the buffer keeps its memory,
+ * so a buffer reused for every serialization stops allocating after the first one.
+ *
+ * @version 0.1
+ * @date 2023-10-05
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef BYTE_BUFFER_H
+#define BYTE_BUFFER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * @brief Appends a variable (not an expression) to the buffer.
+ */
+#define write_value(buffer, value) write_bytes(buffer, &(value), sizeof(value))
+
+/**
+ * @brief Reads the next bytes of the buffer into a variable.
+ */
+#define read_value(buffer, value) read_bytes(buffer, &(value), sizeof(value))
+
+/**
+ * @struct byte_buffer_t
+ * @brief Data structure representing a growable buffer of bytes with a reading position.
+ */
+typedef struct byte_buffer_t {
+    unsigned char *data;     /** The bytes. */
+    size_t size;             /** Number of bytes written. */
+    size_t capacity;         /** Number of bytes allocated. */
+    size_t read_position;    /** Index of the next byte to read. */
+} byte_buffer_t;
+
+/**
+ * @brief Initializes an empty buffer (nothing is allocated until the first write).
+ *
+ * @param buffer The buffer.
+ */
+void init_byte_buffer(byte_buffer_t *buffer);
+
+/**
+ * @brief Removes all the bytes from the buffer and resets the reading position. The memory is kept.
+ *
+ * @param buffer The buffer.
+ */
+void clear_byte_buffer(byte_buffer_t *buffer);
+
+/**
+ * @brief Appends bytes to the buffer.
+ *
+ * @param buffer The buffer.
+ * @param bytes The bytes to append.
+ * @param count The number of the bytes.
+ * @return true on success, false if the memory allocation failed.
+ */
+bool write_bytes(byte_buffer_t *buffer, const void *bytes, size_t count);
+
+/**
+ * @brief Reads the next bytes of the buffer and moves the reading position behind them.
+ *
+ * @param buffer The buffer.
+ * @param bytes Placeholder for the bytes.
+ * @param count The number of the bytes.
+ * @return true on success, false if there are not enough bytes left (nothing is read then).
+ */
+bool read_bytes(byte_buffer_t *buffer, void *bytes, size_t count);
+
+/**
+ * @brief Gets the number of bytes which have not been read yet.
+ *
+ * @param buffer The buffer.
+ * @return The number of bytes.
+ */
+size_t get_remaining_bytes(const byte_buffer_t *buffer);
+
+/**
+ * @brief Writes all the bytes of the buffer into a file.
+ *
+ * @param buffer The buffer.
+ * @param file_path The path of the file.
+ * @return true on success, false on failure.
+ */
+bool save_byte_buffer(const byte_buffer_t *buffer, const char *file_path);
+
+/**
+ * @brief Replaces the content of the buffer with the content of a file.
+ *
+ * @param buffer The buffer.
+ * @param file_path The path of the file.
+ * @return true on success, false on failure.
+ */
+bool load_byte_buffer(byte_buffer_t *buffer, const char *file_path);
+
+/**
+ * @brief Releases the memory of the buffer, it is empty afterwards.
+ *
+ * @param buffer The buffer.
+ */
+void release_byte_buffer(byte_buffer_t *buffer);
+
+#endif
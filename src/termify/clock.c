@@ -0,0 +1,61 @@
+#include <time.h>
+
+#include "clock.h"
+
+// ----------------------------------------- PROGRAM-------------------------------------------- //
+
+nanoseconds_t get_monotonic_time(void)
+{
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (nanoseconds_t)time.tv_sec * NANOSECONDS_IN_SECOND + time.tv_nsec;
+}
+
+void init_frame_scheduler(frame_scheduler_t *scheduler, nanoseconds_t step, nanoseconds_t frame_period, int max_steps_per_frame)
+{
+    scheduler->step = step;
+    scheduler->frame_period = frame_period;
+    scheduler->max_steps_per_frame = (max_steps_per_frame < 1) ? 1 : max_steps_per_frame;
+    scheduler->next_step_time = get_monotonic_time();
+    scheduler->next_frame_time = scheduler->next_step_time;
+    scheduler->frame_time = scheduler->next_step_time;
+}
+
+int start_scheduled_frame(frame_scheduler_t *scheduler)
+{
+    nanoseconds_t now = get_monotonic_time();
+
+    scheduler->frame_time = now;
+    scheduler->next_frame_time += scheduler->frame_period;
+    if (scheduler->next_frame_time <= now) {
+        // the frames which were missed are not rendered, the next one comes a whole period later
+        scheduler->next_frame_time = now + scheduler->frame_period;
+    }
+
+    if (now < scheduler->next_step_time) {
+        return 0;
+    }
+
+    // all the steps whose time has come
+    nanoseconds_t due_steps = (now - scheduler->next_step_time) / scheduler->step + 1;
+
+    if (due_steps > scheduler->max_steps_per_frame) {
+        // too far behind - the backlog is dropped and the schedule continues from now
+        scheduler->next_step_time = now + scheduler->step;
+        return scheduler->max_steps_per_frame;
+    }
+
+    scheduler->next_step_time += due_steps * scheduler->step;
+    return (int)due_steps;
+}
+
+double get_interpolation_factor(const frame_scheduler_t *scheduler)
+{
+    nanoseconds_t last_step_time = scheduler->next_step_time - scheduler->step;
+    double alpha = (double)(scheduler->frame_time - last_step_time) / (double)scheduler->step;
+
+    if (alpha < 0.0) {
+        return 0.0;
+    }
+    return (alpha > 1.0) ? 1.0 : alpha;
+}
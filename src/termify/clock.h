@@ -0,0 +1,83 @@
+/**
+ * @file clock.h
+ * @author Marek Eibel
+ * @brief Header file containing the monotonic clock helpers and the frame scheduler used for pacing game loops.
+ *
+ * The frame scheduler keeps a fixed simulation step and a separate frame period. The loop is woken up by a timer
+ * with the frame period (see `add_timer_source()`), and every frame takes all the simulation steps whose time has come (possibly none, if frames
+ * are rendered more often than the simulation steps) and renders one frame. Positions of the objects are then
+ * interpolated between the last two steps using `get_interpolation_factor()`. The speed of the game is
+ * therefore given by the step only, while the frame period decides how much output goes to the terminal.
+ * If the loop falls behind (slow terminal, suspended process), it catches up by running several steps before
+ * the next frame, and drops the backlog it cannot catch up with.
+ *
+ * @version 0.1
+ * @date 2023-09-24
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include <stdint.h>
+
+#define NANOSECONDS_IN_MILLISECOND 1000000LL
+#define NANOSECONDS_IN_SECOND 1000000000LL
+
+/**
+ * @typedef int64_t nanoseconds_t
+ * @brief Alias for the type used to represent points and durations of the monotonic clock in nanoseconds.
+ */
+typedef int64_t nanoseconds_t;
+
+/**
+ * @struct frame_scheduler_t
+ * @brief Data structure pacing a loop with a fixed simulation step and a fixed frame period.
+ */
+typedef struct frame_scheduler_t {
+    nanoseconds_t step;             /** Duration of one simulation step. */
+    nanoseconds_t frame_period;     /** Duration between two rendered frames. */
+    nanoseconds_t next_step_time;   /** Point of the monotonic clock when the next step is due. */
+    nanoseconds_t next_frame_time;  /** Point of the monotonic clock when the next frame is due. */
+    nanoseconds_t frame_time;       /** Point of the monotonic clock when the current frame started. */
+    int max_steps_per_frame;        /** Maximal number of steps run before one frame is rendered. */
+} frame_scheduler_t;
+
+/**
+ * @brief Reads the monotonic clock.
+ *
+ * @return The current point of the monotonic clock in nanoseconds.
+ */
+nanoseconds_t get_monotonic_time(void);
+
+/**
+ * @brief Initializes a frame scheduler. The first step and the first frame are due immediately.
+ *
+ * @param scheduler The scheduler to initialize.
+ * @param step The duration of one simulation step.
+ * @param frame_period The duration between two rendered frames.
+ * @param max_steps_per_frame The maximal number of steps run before one frame is rendered (at least 1).
+ */
+void init_frame_scheduler(frame_scheduler_t *scheduler, nanoseconds_t step, nanoseconds_t frame_period, int max_steps_per_frame);
+
+/**
+ * @brief Starts a frame now and returns the number of simulation steps which should be run before the frame is rendered.
+ *        It is meant for loops woken up by an external timer (e.g. a timerfd with the frame period). Steps over
+ *        `max_steps_per_frame` are dropped. Frames which were missed are skipped, not caught up.
+ *
+ * @param scheduler The scheduler.
+ * @return The number of steps to run (0 if no step is due yet).
+ */
+int start_scheduled_frame(frame_scheduler_t *scheduler);
+
+/**
+ * @brief Computes how far the current frame lies between the last simulation step and the next one.
+ *
+ * @param scheduler The scheduler.
+ * @return The interpolation factor from 0 (the frame is at the last step) to 1 (the next step is due).
+ */
+double get_interpolation_factor(const frame_scheduler_t *scheduler);
+
+#endif
@@ -1,3 +1,4 @@
+#include <signal.h>
 #include <stdarg.h>
 #include <stdbool.h>
 #include <stdio.h>
@@ -7,49 +8,139 @@
 
 #include "log.h"
 #include "draw.h"
+#include "frame.h"
 #include "utils.h"
 
 // ---------------------------------------- MACROS --------------------------------------------- //
 
-#define CURSOR_TO_BEGINNING_OF_LINE() printf("\r")
-#define CHAR_RIGHT() printf("\033[C")
-#define CHAR_LEFT() printf("\033[D")
-#define ROW_DOWN() printf("\033[B")
-#define ROW_UP() printf("\033[A")
+#define CURSOR_TO_BEGINNING_OF_LINE() emit("\r")
+#define CHAR_RIGHT() emit("\033[C")
+#define CHARS_RIGHT(_count) emit_formatted("\033[%uC", _count)
+#define CHAR_LEFT() emit("\033[D")
+#define ROW_DOWN() emit("\033[B")
+#define ROW_UP() emit("\033[A")
+#define CURSOR_TO(_row, _column) emit_formatted("\033[%u;%uH", _row, _column)
+
+#define CANVAS_ORIGIN_ROW 2
+#define CANVAS_ORIGIN_COLUMN 1
+
+#define BORDER_CACHE_SIZE 4
+#define BORDER_CACHE_BEGIN_CAPACITY 4096
 
 // ------------------------------------ GLOBAL VARIABLE----------------------------------------- //
 
 /**
- * @brief Global ID allocator for scene objects.
- *
- * The `gl_ID_allocater` is a global variable used to assign unique IDs to objects
- * added to the scene. It ensures that each object has a distinct identifier within
- * the scene. The IDs are allocated sequentially as objects are added to the scene.
- * This variable is used for tracking and managing scene objects.
+ * @brief Frame buffer collecting the output of all drawing primitives between `begin_frame()` and `end_frame()`.
+ *        If it is NULL, the primitives print directly to the standard output.
+ */
+static frame_buffer_t *gl_frame_buffer = NULL;
+
+/**
+ * @brief Global counter of the terminal window resizes.
  *
- * Note that the range of available IDs is limited by the range of an unsigned char.
- * Once the maximum ID value is reached, the allocator will wrap around and start
- * reusing IDs.
+ * The counter is incremented by the SIGWINCH handler. Every render state remembers the value it has seen
+ * when it painted the canvas, so a changed value means the terminal content could be lost and the next
+ * frame has to be a full repaint.
+ */
+static volatile sig_atomic_t gl_resize_generation = 0;
+
+/**
+ * @brief Boolean variable holds the state if the SIGWINCH handler was already installed.
+ */
+static bool gl_resize_handler_installed = false;
+
+/**
+ * @struct border_cache_entry_t
+ * @brief Pre-rendered bytes of the borders for one canvas size.
+ */
+typedef struct border_cache_entry_t {
+    px_t height;            /** Height of the canvas the borders were built for. */
+    px_t width;             /** Width of the canvas the borders were built for. */
+    frame_buffer_t *bytes;  /** Built bytes of the borders, or NULL if the entry is empty. */
+} border_cache_entry_t;
+
+/**
+ * @brief Cache of the pre-rendered borders. The application uses only a few canvas sizes, so the entries
+ *        are searched linearly and replaced in a round-robin manner once the cache is full.
  */
-static ID_t gl_ID_allocater = 0;
+static border_cache_entry_t gl_border_cache[BORDER_CACHE_SIZE] = { 0 };
+
+/**
+ * @brief Index of the border cache entry which will be replaced next.
+ */
+static int gl_border_cache_next_entry = 0;
 
 // ---------------------------------- STATIC DECLARATIONS--------------------------------------- //
 
 static void display_button(px_t width, px_t height, px_t padding, const char *text);
 static void display_button_text(px_t width, const char *text);
-static colour_t ID_to_colour(scene_t *scene, ID_t ID);
-static ID_t generate_id();
+static colour_t slot_to_colour(scene_t *scene, ID_slot_t slot);
+static void handle_terminal_resize(int signal_number);
+static void install_resize_handler(void);
+static void put_pixel(colour_t colour, colour_t *current_colour);
+static void set_pixel_colour(colour_t colour, colour_t *current_colour);
+static const char *colour_2_sgr_sequence(colour_t colour);
+static bool clip_object_to_buffer(pixel_buffer_t *pixel_buffer, scene_t *scene, ID_t object, px_t *row_begin, px_t *row_end, px_t *column_begin, px_t *column_end);
+static bool clip_area_to_buffer(pixel_buffer_t *pixel_buffer, px_t position_x, px_t position_y, px_t width, px_t height, px_t *row_begin, px_t *row_end, px_t *column_begin, px_t *column_end);
+static int rasterize_area(pixel_buffer_t *pixel_buffer, ID_slot_t slot, px_t row_begin, px_t row_end, px_t column_begin, px_t column_end, collisions_t *collisions);
+static void store_collision(collisions_t *collisions, ID_slot_t slot);
+static px_t interpolate_position(px_t previous, px_t current, double alpha);
+static bool is_pixel_span_free(const ID_slot_t *span, px_t length);
+static void fill_pixel_span(ID_slot_t *span, px_t length, ID_slot_t slot);
+static frame_buffer_t *get_cached_borders(px_t height, px_t width);
+static void build_borders(px_t height, px_t width);
+static void emit(const char *bytes);
+static void emit_bytes(const char *bytes, size_t length);
+static void emit_char(char c);
+static void emit_formatted(const char *format, ...);
+static void emit_formatted_list(const char *format, va_list args);
+static ID_t allocate_ID(scene_t *scene);
+static void release_ID(scene_t *scene, ID_t ID);
+static bool grow_ID_slots(scene_t *scene, int capacity);
+static bool resize_scene_arrays(scene_t *scene, int length);
+static void move_scene_objects(scene_t *scene, int destination, int source, int count);
+static bool resize_array(void **array, size_t element_size, int length);
+static bool read_scene_objects(scene_t *scene, byte_buffer_t *buffer, int objects_count, int slots_count, int free_slots_count);
+static void reset_ID_slots(scene_t *scene);
 
 // ----------------------------------------- PROGRAM-------------------------------------------- //
 
+void begin_frame(frame_buffer_t *frame)
+{
+    clear_frame_buffer(frame);
+    gl_frame_buffer = frame;
+}
+
+int end_frame(void)
+{
+    if (gl_frame_buffer == NULL) {
+        return 0;
+    }
+
+    frame_buffer_t *frame = gl_frame_buffer;
+    gl_frame_buffer = NULL;
+
+    // anything printed through stdio in the meantime must not get behind the frame
+    fflush(stdout);
+    return write_frame_buffer(frame, STDOUT_FILENO);
+}
+
+void write_raw_text(const char* format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    emit_formatted_list(format, args);
+    va_end(args);
+}
+
 void clear_canvas(void)
 {
-    printf("\033[2J\033[H");
+    emit("\033[2J\033[H");
 }
 
 void set_cursor_at_beginning_of_window(void)
 {
-    printf("\033[H");
+    emit("\033[H");
 }
 
 void set_cursor_at_beginning_of_canvas(void)
@@ -60,38 +151,34 @@ void set_cursor_at_beginning_of_canvas(void)
 
 void hide_cursor()
 {
-    printf("\033[?25l");
+    emit("\033[?25l");
 }
 
 void show_cursor()
 {
-    printf("\033[?25h");
+    emit("\033[?25h");
 }
 
 void draw_borders(px_t height, px_t width)
 {
     set_cursor_at_beginning_of_window();
-    width += 1; height += 1;
 
-    printf("┌");
-    for (int i = 0; i < width - 2; ++i) {
-        printf("─");
+    frame_buffer_t *borders = get_cached_borders(height, width);
+    if (borders == NULL) {
+        build_borders(height, width);
+        return;
     }
-    printf("┐\n");
 
-    for (int i = 0; i < height - 2; ++i) {
-        printf("│");
-        for (int j = 0; j < width - 2; ++j) {
-            printf(" ");
-        }
-        printf("│\n");
-    }
+    emit_bytes(borders->data, borders->length);
+}
 
-    printf("└");
-    for (int i = 0; i < width - 2; ++i) {
-        printf("─");
+void release_border_cache(void)
+{
+    for (int i = 0; i < BORDER_CACHE_SIZE; ++i) {
+        release_frame_buffer(gl_border_cache[i].bytes);
+        gl_border_cache[i].bytes = NULL;
     }
-    printf("┘\n");
+    gl_border_cache_next_entry = 0;
 }
 
 void put_text(const char* text, px_t line_width, position_t pos)
@@ -107,21 +194,21 @@ void put_text(const char* text, px_t line_width, position_t pos)
         CHAR_RIGHT();
         px_t center_padding = (line_width - text_length) / 2;
         for (int i = 0; i < center_padding; i++) {
-            putchar(' ');
+            emit_char(' ');
         }
         break;
     case RIGHT:
         CHAR_RIGHT();
         px_t right_padding = (line_width - text_length);
         for (int i = 0; i < right_padding - 1; i++) {
-            putchar(' ');
+            emit_char(' ');
         }
         break;
     default:
         break;
     }
 
-    printf("%s", text);
+    emit(text);
     CURSOR_TO_BEGINNING_OF_LINE();
     ROW_DOWN();
 }
@@ -132,7 +219,7 @@ void write_text(const char* format, ...)
     va_start(args, format);
     
     CHAR_RIGHT();
-    vprintf(format, args);
+    emit_formatted_list(format, args);
     
     va_end(args);
 }
@@ -177,7 +264,7 @@ void put_horizontal_line(px_t line_width, char symbol)
 {
     CHAR_RIGHT();
     for (unsigned int i = 0; i < line_width; ++i) {
-        putchar(symbol);
+        emit_char(symbol);
     }
     CURSOR_TO_BEGINNING_OF_LINE();
     ROW_DOWN();
@@ -192,7 +279,7 @@ pixel_buffer_t *create_pixel_buffer(px_t height, px_t width)
     }
 
     pixel_buffer->height = height; pixel_buffer->width = width;
-    pixel_buffer->buff = calloc(height * width, sizeof(unsigned char));
+    pixel_buffer->buff = calloc(height * width, sizeof(ID_slot_t));
 
     if (pixel_buffer->buff == NULL) {
         resolve_error(MEM_ALOC_FAILURE, NULL);
@@ -206,17 +293,21 @@ pixel_buffer_t *create_pixel_buffer(px_t height, px_t width)
 scene_t *create_scene()
 {
     const int BEGIN_ARRAY_SIZE = 4;
-    scene_t *scene = malloc(sizeof(scene_t));
+    scene_t *scene = calloc(1, sizeof(scene_t));
     if (scene == NULL) {
         return NULL;
     }
 
     scene->number_of_objects = 0;
-    scene->length_of_arr = BEGIN_ARRAY_SIZE;
-    scene->scene = malloc(sizeof(rectangle_t*) * scene->length_of_arr);
+    scene->length_of_arr = 0;
+
+    // slot 0 is taken from the beginning, so that no object gets UNDEFINIED_ID
+    scene->ID_allocator.slots_count = 1;
+    scene->ID_allocator.capacity = 0;
+    scene->ID_allocator.free_slots_count = 0;
 
-    if (scene->scene == NULL) {
-        free(scene);
+    if (!resize_scene_arrays(scene, BEGIN_ARRAY_SIZE) || !grow_ID_slots(scene, BEGIN_ARRAY_SIZE)) {
+        release_scene(scene);
         return NULL;
     }
 
@@ -230,204 +321,412 @@ void release_scene(scene_t *scene)
         return;
     }
 
-    for (int i = 0; i < scene->number_of_objects; ++i) {
-        release_rectangle(scene->scene[i]);
-    }
-
-    free(scene->scene);
+    free(scene->IDs);
+    free(scene->positions_x);
+    free(scene->positions_y);
+    free(scene->previous_positions_x);
+    free(scene->previous_positions_y);
+    free(scene->widths);
+    free(scene->heights);
+    free(scene->x_speeds);
+    free(scene->y_speeds);
+    free(scene->names);
+    free(scene->ID_allocator.generations);
+    free(scene->ID_allocator.free_slots);
+    free(scene->slot_indices);
+    free(scene->palette);
     free(scene);
 }
 
-rectangle_t *add_to_scene(scene_t *scene, rectangle_t *object)
+ID_t add_to_scene(scene_t *scene, const rectangle_t *object)
 {
     const int GROWTH_FACTOR = 2;
 
     if (scene == NULL || object == NULL) {
-        return NULL;
+        return UNDEFINIED_ID;
     }
 
-    if (scene->number_of_objects >= scene->length_of_arr) {
-        scene->length_of_arr *= GROWTH_FACTOR;
-        rectangle_t **new_scene_arr = realloc(scene->scene, sizeof(rectangle_t*) * scene->length_of_arr);
-        if (new_scene_arr == NULL) {
-            return NULL;
-        }
-        scene->scene = new_scene_arr;
+    if (scene->number_of_objects >= scene->length_of_arr && !resize_scene_arrays(scene, scene->length_of_arr * GROWTH_FACTOR)) {
+        return UNDEFINIED_ID;
     }
 
-    scene->scene[scene->number_of_objects++] = object;
-    return object;
+    ID_t ID = allocate_ID(scene);
+    if (ID == UNDEFINIED_ID) {
+        return UNDEFINIED_ID;
+    }
+
+    int index = scene->number_of_objects++;
+    scene->IDs[index] = ID;
+    scene->positions_x[index] = object->position_x;
+    scene->positions_y[index] = object->position_y;
+    scene->previous_positions_x[index] = object->position_x;
+    scene->previous_positions_y[index] = object->position_y;
+    scene->widths[index] = object->width;
+    scene->heights[index] = object->height;
+    scene->x_speeds[index] = object->x_speed;
+    scene->y_speeds[index] = object->y_speed;
+    memcpy(scene->names[index], object->name, MAX_OBJECT_NAME_LENGTH);
+
+    scene->slot_indices[ID_TO_SLOT(ID)] = index;
+    scene->palette[ID_TO_SLOT(ID)] = object->colour;
+    return ID;
 }
 
-rectangle_t *remove_object_from_scene(scene_t *scene, rectangle_t *object)
+bool remove_object_from_scene(scene_t *scene, ID_t object, bool keep_order)
 {
-    if (scene == NULL || object == NULL) {
-        return NULL;
-    }
+    const int BEGIN_ARRAY_SIZE = 4;
+    const int SHRINK_DIVISOR = 4;
 
-    int index = -1;
-    for (int i = 0; i < scene->number_of_objects; i++) {
-        if (scene->scene[i] == object) {
-            index = i;
-            break;
-        }
+    if (scene == NULL) {
+        return false;
     }
 
+    int index = get_object_index(scene, object);
     if (index == -1) {
-        return NULL;
+        return false;
     }
 
-    for (int i = index; i < scene->number_of_objects - 1; i++) {
-        scene->scene[i] = scene->scene[i + 1];
+    int last_index = scene->number_of_objects - 1;
+    if (keep_order) {
+        // the following objects are moved one index down
+        move_scene_objects(scene, index, index + 1, last_index - index);
+    } else if (index != last_index) {
+        // the last object takes the place of the removed one
+        move_scene_objects(scene, index, last_index, 1);
     }
 
     scene->number_of_objects--;
+    release_ID(scene, object);
 
-    if (scene->number_of_objects < scene->length_of_arr / 2) {
-        scene->length_of_arr /= 2;
-        rectangle_t **new_scene_arr = realloc(scene->scene, sizeof(rectangle_t*) * scene->length_of_arr);
-        if (new_scene_arr == NULL) {
-            return NULL;
-        }
-        scene->scene = new_scene_arr;
-    }
-
-    return object;
-}
-
-void render_graphics(pixel_buffer_t *pixel_buffer, scene_t *scene)
-{
-    for (unsigned int i = 0; i < pixel_buffer->height; ++i) {
-        for (unsigned int j = 0; j < pixel_buffer->width; ++j) {
-
-            int ID = pixel_buffer->buff[i * pixel_buffer->width + j];
-            colour_t pixel = ID_to_colour(scene, ID);
-            
-            switch (pixel) {
-                case BLACK:
-                    CHAR_RIGHT(); break;
-                case WHITE:
-                    printf("\033[0;97m█\033[0m"); break;
-                case RED:
-                    printf("\033[0;91m█\033[0m"); break;
-                case GREEN:
-                    printf("\033[0;92m█\033[0m"); break;
-                case BLUE:
-                    printf("\033[0;94m█\033[0m"); break;
-                case YELLOW:
-                    printf("\033[0;93m█\033[0m"); break;
-                case ORANGE:
-                    printf("\033[38;5;208m█\033[0m"); break; 
-                case MAGENTA:
-                    printf("\033[0;95m█\033[0m"); break;
-                case CYAN:
-                    printf("\033[0;96m█\033[0m"); break;
-                case LIGHT_GRAY:
-                    printf("\033[0;37m█\033[0m"); break;
-                case DARK_GRAY:
-                    printf("\033[0;90m█\033[0m"); break;
-                case LIGHT_RED:
-                    printf("\033[0;31m█\033[0m"); break;
-                case LIGHT_GREEN:
-                    printf("\033[0;32m█\033[0m"); break;
-                case LIGHT_BLUE:
-                    printf("\033[0;34m█\033[0m"); break;
-                case LIGHT_YELLOW:
-                    printf("\033[0;33m█\033[0m"); break;
-                case LIGHT_MAGENTA:
-                    printf("\033[0;35m█\033[0m"); break;
-                case LIGHT_CYAN:
-                    printf("\033[0;36m█\033[0m"); break;
-                default:
-                    CHAR_RIGHT(); break;
-            }
+    // the arrays shrink only when they are mostly empty, so that adding and removing objects around
+    // one size does not reallocate them every time
+    if (scene->length_of_arr > BEGIN_ARRAY_SIZE && scene->number_of_objects <= scene->length_of_arr / SHRINK_DIVISOR) {
+        (void)resize_scene_arrays(scene, scene->length_of_arr / 2);
+    }
+
+    return true;
+}
+
+ID_t find_object_by_name(scene_t *scene, const char *name)
+{
+    for (int i = 0; i < scene->number_of_objects; ++i) {
+        if (strncmp(scene->names[i], name, MAX_OBJECT_NAME_LENGTH) == 0) {
+            return scene->IDs[i];
         }
-        putchar('\n');
     }
+    return UNDEFINIED_ID;
 }
 
-void release_pixel_buffer(pixel_buffer_t *pixel_buffer)
+int get_object_index(scene_t *scene, ID_t ID)
 {
-    if (pixel_buffer != NULL) {
-        free(pixel_buffer->buff);
-        free(pixel_buffer);   
+    if (!is_ID_alive(scene, ID)) {
+        return -1;
     }
+    return scene->slot_indices[ID_TO_SLOT(ID)];
 }
 
-ID_t compute_object_pixels_in_buffer(pixel_buffer_t *pixel_buffer, rectangle_t *object)
+void set_object_colour(scene_t *scene, ID_t object, colour_t colour)
 {
-    if (object == NULL) {
-        return UNDEFINIED_ID;
+    if (is_ID_alive(scene, object)) {
+        scene->palette[ID_TO_SLOT(object)] = colour;
     }
+}
 
-    for (px_t i = object->position_y; i < object->position_y + object->height; ++i) {
-        for (px_t j = object->position_x; j < object->position_x + object->width; ++j) {
+colour_t get_object_colour(scene_t *scene, ID_t object)
+{
+    return is_ID_alive(scene, object) ? scene->palette[ID_TO_SLOT(object)] : BLACK;
+}
 
-            if ((i * pixel_buffer->width + j) >= 0 && (i * pixel_buffer->width + j) < pixel_buffer->height * pixel_buffer->width) {
-                if (pixel_buffer->buff[i * pixel_buffer->width + j] != UNDEFINIED_ID) {
-                    return pixel_buffer->buff[i * pixel_buffer->width + j];
-                } else {
-                    pixel_buffer->buff[i * pixel_buffer->width + j] = object->ID;
-                }
-            }   
-        }
+void save_scene_positions(scene_t *scene)
+{
+    memcpy(scene->previous_positions_x, scene->positions_x, sizeof(px_t) * scene->number_of_objects);
+    memcpy(scene->previous_positions_y, scene->positions_y, sizeof(px_t) * scene->number_of_objects);
+}
+
+void reset_object_interpolation(scene_t *scene, ID_t object)
+{
+    int index = get_object_index(scene, object);
+    if (index != -1) {
+        scene->previous_positions_x[index] = scene->positions_x[index];
+        scene->previous_positions_y[index] = scene->positions_y[index];
     }
+}
 
-    return UNDEFINIED_ID;
+bool is_ID_alive(scene_t *scene, ID_t ID)
+{
+    ID_slot_t slot = ID_TO_SLOT(ID);
+    if (slot == UNDEFINIED_ID || slot >= scene->ID_allocator.slots_count) {
+        return false;
+    }
+    return scene->ID_allocator.generations[slot] == ID_TO_GENERATION(ID);
 }
 
-void clear_object_pixels_in_buffer(pixel_buffer_t *pixel_buffer, rectangle_t *object)
+bool write_scene(scene_t *scene, byte_buffer_t *buffer)
 {
-    for (px_t i = object->position_y; i < object->position_y + object->height; ++i) {
-        for (px_t j = object->position_x; j < object->position_x + object->width; ++j) {
-            if ((i * pixel_buffer->width + j) >= 0 && (i * pixel_buffer->width + j) < pixel_buffer->height * pixel_buffer->width) {
-                pixel_buffer->buff[i * pixel_buffer->width + j] = UNDEFINIED_ID;
-            }
-        }
+    const ID_allocator_t *allocator = &scene->ID_allocator;
+    int count = scene->number_of_objects;
+
+    // only the used parts of the arrays are written, the capacities are not part of the state
+    return write_value(buffer, scene->number_of_objects)
+           && write_value(buffer, allocator->slots_count)
+           && write_value(buffer, allocator->free_slots_count)
+           && write_bytes(buffer, scene->IDs, sizeof(ID_t) * count)
+           && write_bytes(buffer, scene->positions_x, sizeof(px_t) * count)
+           && write_bytes(buffer, scene->positions_y, sizeof(px_t) * count)
+           && write_bytes(buffer, scene->previous_positions_x, sizeof(px_t) * count)
+           && write_bytes(buffer, scene->previous_positions_y, sizeof(px_t) * count)
+           && write_bytes(buffer, scene->widths, sizeof(px_t) * count)
+           && write_bytes(buffer, scene->heights, sizeof(px_t) * count)
+           && write_bytes(buffer, scene->x_speeds, sizeof(int) * count)
+           && write_bytes(buffer, scene->y_speeds, sizeof(int) * count)
+           && write_bytes(buffer, scene->names, MAX_OBJECT_NAME_LENGTH * count)
+           && write_bytes(buffer, allocator->generations, sizeof(uint16_t) * allocator->slots_count)
+           && write_bytes(buffer, allocator->free_slots, sizeof(ID_slot_t) * allocator->free_slots_count)
+           && write_bytes(buffer, scene->palette, sizeof(colour_t) * allocator->slots_count);
+}
+
+bool read_scene(scene_t *scene, byte_buffer_t *buffer)
+{
+    int objects_count, slots_count, free_slots_count;
+    if (!read_value(buffer, objects_count) || !read_value(buffer, slots_count) || !read_value(buffer, free_slots_count)) {
+        return false;
+    }
+
+    // every slot except the reserved slot 0 is held by an object, in the free list or retired
+    if (objects_count < 0 || free_slots_count < 0 || slots_count > MAX_ID_SLOTS
+        || objects_count + free_slots_count + 1 > slots_count) {
+        return false;
     }
+
+    if ((objects_count > scene->length_of_arr && !resize_scene_arrays(scene, objects_count))
+        || (slots_count > scene->ID_allocator.capacity && !grow_ID_slots(scene, slots_count))) {
+        return false;
+    }
+
+    if (!read_scene_objects(scene, buffer, objects_count, slots_count, free_slots_count)) {
+        scene->number_of_objects = 0;
+        scene->ID_allocator.slots_count = 1;
+        scene->ID_allocator.free_slots_count = 0;
+        reset_ID_slots(scene);
+        return false;
+    }
+
+    return true;
 }
 
-void reset_pixel_buffer(pixel_buffer_t *pixel_buffer)
+void render_graphics(pixel_buffer_t *pixel_buffer, scene_t *scene, render_state_t *render_state)
 {
-    for (int i = 0; i < pixel_buffer->height; i++) {
-        for (int j = 0; j < pixel_buffer->width; j++) {
-            pixel_buffer->buff[i * pixel_buffer->width + j] = UNDEFINIED_ID;
+    if (render_state_needs_full_repaint(render_state)) {
+        for (px_t i = 0; i < render_state->height * render_state->width; ++i) {
+            render_state->screen[i] = BLACK;
+        }
+        render_state->full_repaint = false;
+        render_state->resize_generation = gl_resize_generation;
+    }
+
+    // colour set by the last SGR sequence sent in this frame (BLACK stands for the default attributes)
+    colour_t current_colour = BLACK;
+
+    for (px_t i = 0; i < pixel_buffer->height; ++i) {
+
+        // the cursor position is unknown at the beginning of each row
+        bool cursor_in_row = false;
+        px_t cursor_column = 0;
+
+        for (px_t j = 0; j < pixel_buffer->width; ++j) {
+
+            colour_t pixel = slot_to_colour(scene, pixel_buffer->buff[i * pixel_buffer->width + j]);
+            colour_t *shown_pixel = &render_state->screen[i * render_state->width + j];
+
+            if (pixel == *shown_pixel) {
+                continue;
+            }
+
+            // skip the run of unchanged cells with one cursor movement
+            if (!cursor_in_row) {
+                CURSOR_TO(CANVAS_ORIGIN_ROW + i, CANVAS_ORIGIN_COLUMN + j);
+            } else if (cursor_column != j) {
+                CHARS_RIGHT(j - cursor_column);
+            }
+
+            if (pixel == BLACK && render_state->column_backgrounds[j] != NULL) {
+                set_pixel_colour(BLACK, &current_colour);
+                emit(render_state->column_backgrounds[j]);
+            } else {
+                put_pixel(pixel, &current_colour);
+            }
+
+            *shown_pixel = pixel;
+            cursor_in_row = true;
+            cursor_column = j + 1;
         }
     }
+
+    set_pixel_colour(BLACK, &current_colour);
+    CURSOR_TO(CANVAS_ORIGIN_ROW + pixel_buffer->height, CANVAS_ORIGIN_COLUMN);
 }
 
-rectangle_t *create_rectangle(px_t position_x, px_t position_y, px_t width, px_t height, int x_speed, int y_speed, colour_t colour, const char *name)
+render_state_t *create_render_state(px_t height, px_t width)
 {
-    rectangle_t *rectangle = malloc(sizeof(rectangle_t));
-    if (rectangle == NULL) {
+    render_state_t *render_state = malloc(sizeof(render_state_t));
+    if (render_state == NULL) {
+        resolve_error(MEM_ALOC_FAILURE, NULL);
         return NULL;
     }
 
-    rectangle->ID = generate_id();
-    rectangle->position_x = position_x; rectangle->position_y = position_y;
-    rectangle->x_speed = x_speed; rectangle->y_speed = y_speed;
-    rectangle->width = width * 2; rectangle->height = height;
-    rectangle->colour = colour;
-    rectangle->name = malloc(strlen(name) + 1);
+    render_state->screen = malloc(sizeof(colour_t) * height * width);
+    if (render_state->screen == NULL) {
+        resolve_error(MEM_ALOC_FAILURE, NULL);
+        free(render_state);
+        return NULL;
+    }
 
-    if (rectangle->name == NULL) {
-        free(rectangle);
+    render_state->column_backgrounds = calloc(width, sizeof(const char*));
+    if (render_state->column_backgrounds == NULL) {
+        resolve_error(MEM_ALOC_FAILURE, NULL);
+        free(render_state->screen);
+        free(render_state);
         return NULL;
     }
 
-    strcpy((char*)rectangle->name, name);
+    install_resize_handler();
 
-    return rectangle;
+    render_state->height = height; render_state->width = width;
+    render_state->full_repaint = true;
+    render_state->resize_generation = gl_resize_generation;
+
+    return render_state;
+}
+
+void set_render_state_column_background(render_state_t *render_state, px_t column, const char *glyph)
+{
+    if (column < render_state->width) {
+        render_state->column_backgrounds[column] = glyph;
+    }
+}
+
+void invalidate_render_state(render_state_t *render_state)
+{
+    render_state->full_repaint = true;
+}
+
+void notify_terminal_resize(void)
+{
+    gl_resize_generation++;
+}
+
+bool render_state_needs_full_repaint(render_state_t *render_state)
+{
+    return render_state->full_repaint || render_state->resize_generation != gl_resize_generation;
+}
+
+void release_render_state(render_state_t *render_state)
+{
+    if (render_state != NULL) {
+        free(render_state->screen);
+        free(render_state->column_backgrounds);
+        free(render_state);
+    }
+}
+
+void release_pixel_buffer(pixel_buffer_t *pixel_buffer)
+{
+    if (pixel_buffer != NULL) {
+        free(pixel_buffer->buff);
+        free(pixel_buffer);   
+    }
+}
+
+int compute_object_pixels_in_buffer(pixel_buffer_t *pixel_buffer, scene_t *scene, ID_t object, collisions_t *collisions)
+{
+    if (collisions != NULL) {
+        collisions->count = 0;
+        collisions->truncated = false;
+    }
+
+    px_t row_begin, row_end, column_begin, column_end;
+    if (!clip_object_to_buffer(pixel_buffer, scene, object, &row_begin, &row_end, &column_begin, &column_end)) {
+        return 0;
+    }
+
+    return rasterize_area(pixel_buffer, ID_TO_SLOT(object), row_begin, row_end, column_begin, column_end, collisions);
+}
+
+void init_collisions(collisions_t *collisions)
+{
+    collisions->count = 0;
+    collisions->capacity = 0;
+    collisions->slots = NULL;
+    collisions->truncated = false;
+}
+
+void release_collisions(collisions_t *collisions)
+{
+    free(collisions->slots);
+    init_collisions(collisions);
+}
+
+bool collisions_contain(collisions_t *collisions, ID_t ID)
+{
+    if (collisions == NULL) {
+        return false;
+    }
+
+    for (int i = 0; i < collisions->count; ++i) {
+        if (collisions->slots[i] == ID_TO_SLOT(ID)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void clear_object_pixels_in_buffer(pixel_buffer_t *pixel_buffer, scene_t *scene, ID_t object)
+{
+    px_t row_begin, row_end, column_begin, column_end;
+    if (!clip_object_to_buffer(pixel_buffer, scene, object, &row_begin, &row_end, &column_begin, &column_end)) {
+        return;
+    }
+
+    for (px_t i = row_begin; i < row_end; ++i) {
+        fill_pixel_span(&pixel_buffer->buff[i * pixel_buffer->width + column_begin], column_end - column_begin, UNDEFINIED_ID);
+    }
 }
 
-void release_rectangle(rectangle_t *rectangle)
+void compute_interpolated_scene_pixels_in_buffer(pixel_buffer_t *pixel_buffer, scene_t *scene, double alpha)
 {
-    if (rectangle != NULL) {
-        free((char*)rectangle->name);
-        free(rectangle);
+    reset_pixel_buffer(pixel_buffer);
+
+    for (int i = 0; i < scene->number_of_objects; ++i) {
+        px_t position_x = interpolate_position(scene->previous_positions_x[i], scene->positions_x[i], alpha);
+        px_t position_y = interpolate_position(scene->previous_positions_y[i], scene->positions_y[i], alpha);
+
+        px_t row_begin, row_end, column_begin, column_end;
+        if (clip_area_to_buffer(pixel_buffer, position_x, position_y, scene->widths[i], scene->heights[i], &row_begin, &row_end, &column_begin, &column_end)) {
+            (void)rasterize_area(pixel_buffer, ID_TO_SLOT(scene->IDs[i]), row_begin, row_end, column_begin, column_end, NULL);
+        }
     }
 }
 
+void reset_pixel_buffer(pixel_buffer_t *pixel_buffer)
+{
+    fill_pixel_span(pixel_buffer->buff, pixel_buffer->height * pixel_buffer->width, UNDEFINIED_ID);
+}
+
+rectangle_t create_rectangle(px_t position_x, px_t position_y, px_t width, px_t height, int x_speed, int y_speed, colour_t colour, const char *name)
+{
+    rectangle_t rectangle;
+
+    rectangle.position_x = position_x; rectangle.position_y = position_y;
+    rectangle.x_speed = x_speed; rectangle.y_speed = y_speed;
+    rectangle.width = width * 2; rectangle.height = height;
+    rectangle.colour = colour;
+
+    strncpy(rectangle.name, name, MAX_OBJECT_NAME_LENGTH - 1);
+    rectangle.name[MAX_OBJECT_NAME_LENGTH - 1] = '\0';
+
+    return rectangle;
+}
+
 const char* colour_2_string(colour_t colour)
 {
     switch (colour)
@@ -470,27 +769,27 @@ static void display_button(px_t width, px_t height, px_t padding, const char *te
         CHAR_RIGHT();
     }
 
-    printf("┌");
+    emit("┌");
     for (int i = 0; i < width - 2; ++i) {
-        printf("─");
+        emit("─");
     }
-    printf("┐\n");
+    emit("┐\n");
 
     for (int i = 0; i < height - 2; ++i) {
         CHAR_RIGHT();
         for (int i = 0; i < padding; ++i) {
             CHAR_RIGHT();
         }
-        printf("│");
+        emit("│");
 
         if (i == (height - 2) / 2) {
             display_button_text(width, text);
         } else {
             for (int j = 0; j < width - 2; ++j) {
-                printf(" ");
+                emit(" ");
             }
         }
-        printf("│\n");
+        emit("│\n");
     }
 
     CHAR_RIGHT();
@@ -498,11 +797,11 @@ static void display_button(px_t width, px_t height, px_t padding, const char *te
         CHAR_RIGHT();
     }
 
-    printf("└");
+    emit("└");
     for (int i = 0; i < width - 2; ++i) {
-        printf("─");
+        emit("─");
     }
-    printf("┘");
+    emit("┘");
 }
 
 /**
@@ -523,39 +822,685 @@ static void display_button_text(px_t width, const char *text)
     }
 
     for (int j = 0; j < (width - 1) / 2 - (strlen(text) / 2); ++j) {
-        printf(" ");
+        emit(" ");
     }
 
-    printf("%s", text);
+    emit(text);
 
     for (int j = 0; j < (width - 1) / 2 - (strlen(text) / 2) + text_length_equalizer; ++j) {
-        printf(" ");
+        emit(" ");
     }
 }
 
 /**
- * @brief Generates a unique ID for objects in the scene.
+ * @brief Prints one cell of the canvas in the given colour at the current cursor position.
+ *        Black cells are printed as spaces, so that they erase whatever was shown there before.
+ *        The SGR sequence is sent only if the colour differs from the one which is currently set.
  * 
- * @return The generated unique ID.
+ * @param colour The colour of the cell.
+ * @param current_colour The colour currently set on the terminal, updated by the function.
  */
-static ID_t generate_id()
+static void put_pixel(colour_t colour, colour_t *current_colour)
 {
-    return ++gl_ID_allocater;
+    set_pixel_colour(colour, current_colour);
+    emit((colour_2_sgr_sequence(colour) == NULL) ? " " : "█");
 }
 
 /**
- * @brief Maps an ID to a colour for rendering.
+ * @brief Sends the SGR sequence of the given colour unless the colour is already set.
  * 
- * @param scene The scene containing objects.
- * @param ID The ID to map to a colour.
- * @return The colour corresponding to the given ID.
+ * @param colour The colour to set. BLACK (and any colour without its sequence) resets the attributes.
+ * @param current_colour The colour currently set on the terminal, updated by the function.
  */
-static colour_t ID_to_colour(scene_t *scene, ID_t ID)
+static void set_pixel_colour(colour_t colour, colour_t *current_colour)
 {
-    for (int i = 0; i < scene->number_of_objects; ++i) {
-        if (scene->scene[i]->ID == ID) {
-            return scene->scene[i]->colour;
+    const char *sgr_sequence = colour_2_sgr_sequence(colour);
+    if (sgr_sequence == NULL) {
+        colour = BLACK;
+    }
+
+    if (colour == *current_colour) {
+        return;
+    }
+
+    emit((sgr_sequence == NULL) ? "\033[0m" : sgr_sequence);
+    *current_colour = colour;
+}
+
+/**
+ * @brief Converts a colour to the SGR sequence setting it as the foreground colour.
+ * 
+ * @param colour The colour to convert.
+ * @return The SGR sequence, or NULL for BLACK and unknown colours (they are drawn as empty cells).
+ */
+static const char *colour_2_sgr_sequence(colour_t colour)
+{
+    switch (colour)
+    {
+        case WHITE:         return "\033[0;97m";
+        case RED:           return "\033[0;91m";
+        case GREEN:         return "\033[0;92m";
+        case BLUE:          return "\033[0;94m";
+        case YELLOW:        return "\033[0;93m";
+        case ORANGE:        return "\033[0;38;5;208m";
+        case MAGENTA:       return "\033[0;95m";
+        case CYAN:          return "\033[0;96m";
+        case LIGHT_GRAY:    return "\033[0;37m";
+        case DARK_GRAY:     return "\033[0;90m";
+        case LIGHT_RED:     return "\033[0;31m";
+        case LIGHT_GREEN:   return "\033[0;32m";
+        case LIGHT_BLUE:    return "\033[0;34m";
+        case LIGHT_YELLOW:  return "\033[0;33m";
+        case LIGHT_MAGENTA: return "\033[0;35m";
+        case LIGHT_CYAN:    return "\033[0;36m";
+        default:            return NULL;
+    }
+}
+
+/**
+ * @brief Clips the area of an object against the pixel buffer.
+ * 
+ * @param pixel_buffer The pixel buffer.
+ * @param scene The scene holding the object.
+ * @param object The ID of the object to clip.
+ * @param row_begin The first row of the visible area (output).
+ * @param row_end The row after the last row of the visible area (output).
+ * @param column_begin The first column of the visible area (output).
+ * @param column_end The column after the last column of the visible area (output).
+ * @return true if at least one pixel of the object lies inside the buffer, false otherwise (or if the ID is not alive).
+ */
+static bool clip_object_to_buffer(pixel_buffer_t *pixel_buffer, scene_t *scene, ID_t object, px_t *row_begin, px_t *row_end, px_t *column_begin, px_t *column_end)
+{
+    int index = get_object_index(scene, object);
+    if (index == -1) {
+        return false;
+    }
+
+    return clip_area_to_buffer(pixel_buffer, scene->positions_x[index], scene->positions_y[index], scene->widths[index], scene->heights[index],
+                               row_begin, row_end, column_begin, column_end);
+}
+
+/**
+ * @brief Clips a rectangular area against the pixel buffer.
+ * 
+ * @param pixel_buffer The pixel buffer.
+ * @param position_x The horizontal coordinate of the top-left corner of the area.
+ * @param position_y The vertical coordinate of the top-left corner of the area.
+ * @param width The width of the area.
+ * @param height The height of the area.
+ * @param row_begin The first row of the visible area (output).
+ * @param row_end The row after the last row of the visible area (output).
+ * @param column_begin The first column of the visible area (output).
+ * @param column_end The column after the last column of the visible area (output).
+ * @return true if at least one pixel of the area lies inside the buffer, false otherwise.
+ */
+static bool clip_area_to_buffer(pixel_buffer_t *pixel_buffer, px_t position_x, px_t position_y, px_t width, px_t height, px_t *row_begin, px_t *row_end, px_t *column_begin, px_t *column_end)
+{
+    if (position_y >= pixel_buffer->height || position_x >= pixel_buffer->width) {
+        return false;
+    }
+
+    *row_begin = position_y;
+    *column_begin = position_x;
+
+    // compared against the remaining space, so that huge sizes cannot overflow
+    *row_end = (height > pixel_buffer->height - position_y) ? pixel_buffer->height : position_y + height;
+    *column_end = (width > pixel_buffer->width - position_x) ? pixel_buffer->width : position_x + width;
+
+    return *row_begin < *row_end && *column_begin < *column_end;
+}
+
+/**
+ * @brief Writes the slot into the clipped area of the pixel buffer. Pixels already occupied by other objects are kept
+ *        and the objects are reported as collisions.
+ * 
+ * @param pixel_buffer The pixel buffer.
+ * @param slot The slot of the ID of the rasterized object.
+ * @param row_begin The first row of the area.
+ * @param row_end The row after the last row of the area.
+ * @param column_begin The first column of the area.
+ * @param column_end The column after the last column of the area.
+ * @param collisions The structure filled with the slots of the overlapped objects, or NULL if they are not needed.
+ * @return The number of distinct objects the area overlaps.
+ */
+static int rasterize_area(pixel_buffer_t *pixel_buffer, ID_slot_t slot, px_t row_begin, px_t row_end, px_t column_begin, px_t column_end, collisions_t *collisions)
+{
+    int collisions_count = 0;
+    px_t span_length = column_end - column_begin;
+
+    // slots already counted in this call, cleared only once an occupied span is found
+    uint64_t seen_slots[MAX_ID_SLOTS / 64];
+    bool seen_slots_cleared = false;
+
+    for (px_t i = row_begin; i < row_end; ++i) {
+        ID_slot_t *span = &pixel_buffer->buff[i * pixel_buffer->width + column_begin];
+
+        // free spans (the common case) are filled at once, pixels of other objects are never overwritten
+        if (is_pixel_span_free(span, span_length)) {
+            fill_pixel_span(span, span_length, slot);
+            continue;
+        }
+
+        if (!seen_slots_cleared) {
+            memset(seen_slots, 0, sizeof(seen_slots));
+            seen_slots_cleared = true;
+        }
+
+        for (px_t j = 0; j < span_length; ++j) {
+            if (span[j] == UNDEFINIED_ID) {
+                span[j] = slot;
+                continue;
+            }
+
+            uint64_t mask = (uint64_t)1 << (span[j] % 64);
+            if (seen_slots[span[j] / 64] & mask) {
+                continue;
+            }
+            seen_slots[span[j] / 64] |= mask;
+
+            collisions_count += 1;
+            if (collisions != NULL) {
+                store_collision(collisions, span[j]);
+            }
+        }
+    }
+
+    return collisions_count;
+}
+
+/**
+ * @brief Appends a slot to the collisions, growing their storage if needed. If the storage cannot grow,
+ *        the collisions are marked as truncated.
+ * 
+ * @param collisions The collisions.
+ * @param slot The slot of the overlapped object.
+ */
+static void store_collision(collisions_t *collisions, ID_slot_t slot)
+{
+    if (collisions->count == collisions->capacity) {
+        int new_capacity = (collisions->capacity == 0) ? INITIAL_COLLISIONS_CAPACITY : collisions->capacity * 2;
+        ID_slot_t *new_slots = realloc(collisions->slots, new_capacity * sizeof(ID_slot_t));
+        if (new_slots == NULL) {
+            collisions->truncated = true;
+            return;
+        }
+        collisions->slots = new_slots;
+        collisions->capacity = new_capacity;
+    }
+
+    collisions->slots[collisions->count++] = slot;
+}
+
+/**
+ * @brief Interpolates one coordinate between two simulation steps. The result is rounded to the nearest pixel.
+ * 
+ * @param previous The coordinate before the last step.
+ * @param current The coordinate after the last step.
+ * @param alpha The interpolation factor between 0 and 1.
+ * @return The interpolated coordinate.
+ */
+static px_t interpolate_position(px_t previous, px_t current, double alpha)
+{
+    double offset = ((double)current - (double)previous) * alpha;
+    return (px_t)((double)previous + offset + 0.5);
+}
+
+/**
+ * @brief Checks whether no object occupies any pixel of the span.
+ * 
+ * @param span The first pixel of the span.
+ * @param length The number of pixels in the span.
+ * @return true if all the pixels are UNDEFINIED_ID, false otherwise.
+ */
+static bool is_pixel_span_free(const ID_slot_t *span, px_t length)
+{
+    // accumulated without branching, so that the loop can be vectorized
+    ID_slot_t occupied = UNDEFINIED_ID;
+    for (px_t i = 0; i < length; ++i) {
+        occupied |= span[i];
+    }
+    return occupied == UNDEFINIED_ID;
+}
+
+/**
+ * @brief Sets all the pixels of the span to one slot.
+ * 
+ * @param span The first pixel of the span.
+ * @param length The number of pixels in the span.
+ * @param slot The slot to set.
+ */
+static void fill_pixel_span(ID_slot_t *span, px_t length, ID_slot_t slot)
+{
+    if (slot == UNDEFINIED_ID) {
+        memset(span, 0, length * sizeof(ID_slot_t));
+        return;
+    }
+
+    // a plain loop, which the compiler turns into vector stores (memset cannot fill 16-bit values)
+    for (px_t i = 0; i < length; ++i) {
+        span[i] = slot;
+    }
+}
+
+/**
+ * @brief Finds the pre-rendered borders for the given canvas size. If they are not cached yet, they are built
+ *        and stored in the cache.
+ * 
+ * @param height The height of the canvas.
+ * @param width The width of the canvas.
+ * @return The frame buffer holding the bytes of the borders, or NULL if they could not be built.
+ */
+static frame_buffer_t *get_cached_borders(px_t height, px_t width)
+{
+    for (int i = 0; i < BORDER_CACHE_SIZE; ++i) {
+        border_cache_entry_t *entry = &gl_border_cache[i];
+        if (entry->bytes != NULL && entry->height == height && entry->width == width) {
+            return entry->bytes;
+        }
+    }
+
+    frame_buffer_t *bytes = create_frame_buffer(BORDER_CACHE_BEGIN_CAPACITY);
+    if (bytes == NULL) {
+        return NULL;
+    }
+
+    // the borders are built by the same primitives, only redirected into the cache entry
+    frame_buffer_t *active_frame_buffer = gl_frame_buffer;
+    gl_frame_buffer = bytes;
+    build_borders(height, width);
+    gl_frame_buffer = active_frame_buffer;
+
+    border_cache_entry_t *entry = &gl_border_cache[gl_border_cache_next_entry];
+    gl_border_cache_next_entry = (gl_border_cache_next_entry + 1) % BORDER_CACHE_SIZE;
+
+    release_frame_buffer(entry->bytes);
+    entry->height = height;
+    entry->width = width;
+    entry->bytes = bytes;
+
+    return bytes;
+}
+
+/**
+ * @brief Emits the borders around the canvas, starting at the current cursor position.
+ * 
+ * @param height The height of the canvas.
+ * @param width The width of the canvas.
+ */
+static void build_borders(px_t height, px_t width)
+{
+    width += 1; height += 1;
+
+    emit("┌");
+    for (int i = 0; i < width - 2; ++i) {
+        emit("─");
+    }
+    emit("┐\n");
+
+    for (int i = 0; i < height - 2; ++i) {
+        emit("│");
+        for (int j = 0; j < width - 2; ++j) {
+            emit(" ");
+        }
+        emit("│\n");
+    }
+
+    emit("└");
+    for (int i = 0; i < width - 2; ++i) {
+        emit("─");
+    }
+    emit("┘\n");
+}
+
+/**
+ * @brief Sends bytes to the active frame buffer, or to the standard output if no frame is being built.
+ * 
+ * @param bytes Zero-terminated bytes to send.
+ */
+static void emit(const char *bytes)
+{
+    if (gl_frame_buffer == NULL) {
+        fputs(bytes, stdout);
+        return;
+    }
+    (void)append_to_frame_buffer(gl_frame_buffer, bytes, strlen(bytes));
+}
+
+/**
+ * @brief Sends a block of bytes to the active frame buffer, or to the standard output if no frame is being built.
+ * 
+ * @param bytes Bytes to send.
+ * @param length The number of bytes to send.
+ */
+static void emit_bytes(const char *bytes, size_t length)
+{
+    if (gl_frame_buffer == NULL) {
+        fwrite(bytes, 1, length, stdout);
+        return;
+    }
+    (void)append_to_frame_buffer(gl_frame_buffer, bytes, length);
+}
+
+/**
+ * @brief Sends one character to the active frame buffer, or to the standard output if no frame is being built.
+ * 
+ * @param c The character to send.
+ */
+static void emit_char(char c)
+{
+    if (gl_frame_buffer == NULL) {
+        putchar(c);
+        return;
+    }
+    (void)append_to_frame_buffer(gl_frame_buffer, &c, 1);
+}
+
+/**
+ * @brief Sends formatted text to the active frame buffer, or to the standard output if no frame is being built.
+ * 
+ * @param format The format string for the text.
+ * @param ... Additional arguments for formatting.
+ */
+static void emit_formatted(const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    emit_formatted_list(format, args);
+    va_end(args);
+}
+
+/**
+ * @brief The `va_list` variant of `emit_formatted()`.
+ * 
+ * @param format The format string for the text.
+ * @param args Arguments for formatting.
+ */
+static void emit_formatted_list(const char *format, va_list args)
+{
+    if (gl_frame_buffer == NULL) {
+        vprintf(format, args);
+        return;
+    }
+    (void)append_formatted_to_frame_buffer(gl_frame_buffer, format, args);
+}
+
+/**
+ * @brief Signal handler for SIGWINCH. Marks that the terminal window has been resized.
+ * 
+ * @param signal_number The number of the received signal.
+ */
+static void handle_terminal_resize(int signal_number)
+{
+    (void)signal_number;
+    gl_resize_generation++;
+}
+
+/**
+ * @brief Installs the SIGWINCH handler used for the detection of terminal resizes (only once per process).
+ */
+static void install_resize_handler(void)
+{
+    if (gl_resize_handler_installed) {
+        return;
+    }
+
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = handle_terminal_resize;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESTART;
+
+    if (sigaction(SIGWINCH, &action, NULL) == 0) {
+        gl_resize_handler_installed = true;
+    }
+}
+
+/**
+ * @brief Takes a free ID from the allocator of the scene. Released slots are reused first.
+ * 
+ * @param scene The scene.
+ * @return The allocated ID, or UNDEFINIED_ID if all the slots are taken or the memory allocation failed.
+ */
+static ID_t allocate_ID(scene_t *scene)
+{
+    const int GROWTH_FACTOR = 2;
+
+    ID_allocator_t *allocator = &scene->ID_allocator;
+
+    ID_slot_t slot;
+    if (allocator->free_slots_count > 0) {
+        slot = allocator->free_slots[--allocator->free_slots_count];
+    } else {
+        if (allocator->slots_count >= MAX_ID_SLOTS) {
+            resolve_error(GENERAL_ERROR, "no free object ID is left in the scene.");
+            return UNDEFINIED_ID;
+        }
+        if (allocator->slots_count >= allocator->capacity && !grow_ID_slots(scene, allocator->capacity * GROWTH_FACTOR)) {
+            return UNDEFINIED_ID;
+        }
+        slot = (ID_slot_t)allocator->slots_count++;
+    }
+
+    return MAKE_ID(allocator->generations[slot], slot);
+}
+
+/**
+ * @brief Returns the slot of the ID into the free list of the scene. The generation of the slot is increased,
+ *        so the released ID becomes stale. A slot whose generation reaches `RETIRED_GENERATION` is not reused anymore,
+ *        so the generation never wraps around and an old ID cannot become alive again.
+ * 
+ * @param scene The scene.
+ * @param ID The ID to release.
+ */
+static void release_ID(scene_t *scene, ID_t ID)
+{
+    if (!is_ID_alive(scene, ID)) {
+        return;
+    }
+
+    ID_slot_t slot = ID_TO_SLOT(ID);
+    if (++scene->ID_allocator.generations[slot] != RETIRED_GENERATION) {
+        scene->ID_allocator.free_slots[scene->ID_allocator.free_slots_count++] = slot;
+    }
+    scene->slot_indices[slot] = -1;
+    scene->palette[slot] = BLACK;
+}
+
+/**
+ * @brief Grows the per-slot arrays of the scene (generations, free list, indices and palette).
+ * 
+ * @param scene The scene.
+ * @param capacity The requested capacity (it is limited by MAX_ID_SLOTS).
+ * @return true on success, false if the memory allocation failed.
+ */
+static bool grow_ID_slots(scene_t *scene, int capacity)
+{
+    ID_allocator_t *allocator = &scene->ID_allocator;
+    if (capacity > MAX_ID_SLOTS) {
+        capacity = MAX_ID_SLOTS;
+    }
+
+    if (!resize_array((void**)&allocator->generations, sizeof(uint16_t), capacity) ||
+        !resize_array((void**)&allocator->free_slots, sizeof(ID_slot_t), capacity) ||
+        !resize_array((void**)&scene->slot_indices, sizeof(int), capacity) ||
+        !resize_array((void**)&scene->palette, sizeof(colour_t), capacity)) {
+        return false;
+    }
+
+    for (int i = allocator->capacity; i < capacity; ++i) {
+        allocator->generations[i] = 0;
+        scene->slot_indices[i] = -1;
+        scene->palette[i] = BLACK;
+    }
+    allocator->capacity = capacity;
+
+    return true;
+}
+
+/**
+ * @brief Resizes all the dense arrays of the scene.
+ * 
+ * @param scene The scene.
+ * @param length The new length of the arrays (it must not be lower than the number of objects).
+ * @return true on success, false if the memory allocation failed (the arrays keep at least their old length).
+ */
+static bool resize_scene_arrays(scene_t *scene, int length)
+{
+    if (!resize_array((void**)&scene->IDs, sizeof(ID_t), length) ||
+        !resize_array((void**)&scene->positions_x, sizeof(px_t), length) ||
+        !resize_array((void**)&scene->positions_y, sizeof(px_t), length) ||
+        !resize_array((void**)&scene->previous_positions_x, sizeof(px_t), length) ||
+        !resize_array((void**)&scene->previous_positions_y, sizeof(px_t), length) ||
+        !resize_array((void**)&scene->widths, sizeof(px_t), length) ||
+        !resize_array((void**)&scene->heights, sizeof(px_t), length) ||
+        !resize_array((void**)&scene->x_speeds, sizeof(int), length) ||
+        !resize_array((void**)&scene->y_speeds, sizeof(int), length) ||
+        !resize_array((void**)&scene->names, MAX_OBJECT_NAME_LENGTH, length)) {
+        return false;
+    }
+
+    scene->length_of_arr = length;
+    return true;
+}
+
+/**
+ * @brief Moves a block of objects to another position in the dense arrays of the scene and updates their indices.
+ *        The source and destination blocks may overlap.
+ * 
+ * @param scene The scene.
+ * @param destination The new index of the first moved object.
+ * @param source The current index of the first moved object.
+ * @param count The number of moved objects.
+ */
+static void move_scene_objects(scene_t *scene, int destination, int source, int count)
+{
+    memmove(&scene->IDs[destination], &scene->IDs[source], sizeof(ID_t) * count);
+    memmove(&scene->positions_x[destination], &scene->positions_x[source], sizeof(px_t) * count);
+    memmove(&scene->positions_y[destination], &scene->positions_y[source], sizeof(px_t) * count);
+    memmove(&scene->previous_positions_x[destination], &scene->previous_positions_x[source], sizeof(px_t) * count);
+    memmove(&scene->previous_positions_y[destination], &scene->previous_positions_y[source], sizeof(px_t) * count);
+    memmove(&scene->widths[destination], &scene->widths[source], sizeof(px_t) * count);
+    memmove(&scene->heights[destination], &scene->heights[source], sizeof(px_t) * count);
+    memmove(&scene->x_speeds[destination], &scene->x_speeds[source], sizeof(int) * count);
+    memmove(&scene->y_speeds[destination], &scene->y_speeds[source], sizeof(int) * count);
+    memmove(&scene->names[destination], &scene->names[source], MAX_OBJECT_NAME_LENGTH * count);
+
+    for (int i = destination; i < destination + count; ++i) {
+        scene->slot_indices[ID_TO_SLOT(scene->IDs[i])] = i;
+    }
+}
+
+/**
+ * @brief Reallocates an array to the given number of elements. The array is left untouched on failure.
+ * 
+ * @param array Pointer to the array to reallocate.
+ * @param element_size The size of one element.
+ * @param length The new number of elements.
+ * @return true on success, false if the memory allocation failed.
+ */
+static bool resize_array(void **array, size_t element_size, int length)
+{
+    void *new_array = realloc(*array, element_size * length);
+    if (new_array == NULL) {
+        resolve_error(MEM_ALOC_FAILURE, NULL);
+        return false;
+    }
+
+    *array = new_array;
+    return true;
+}
+
+/**
+ * @brief Reads the arrays written by `write_scene()` into the scene and rebuilds the indices of the slots.
+ *        The arrays of the scene have to be long enough for the given counts.
+ * 
+ * @param scene The scene.
+ * @param buffer The buffer to read from.
+ * @param objects_count The number of objects.
+ * @param slots_count The number of slots taken so far.
+ * @param free_slots_count The number of slots in the free list.
+ * @return true on success, false on invalid data (the scene may be inconsistent then).
+ */
+static bool read_scene_objects(scene_t *scene, byte_buffer_t *buffer, int objects_count, int slots_count, int free_slots_count)
+{
+    ID_allocator_t *allocator = &scene->ID_allocator;
+
+    scene->number_of_objects = objects_count;
+    allocator->slots_count = slots_count;
+    allocator->free_slots_count = free_slots_count;
+
+    if (!read_bytes(buffer, scene->IDs, sizeof(ID_t) * objects_count)
+        || !read_bytes(buffer, scene->positions_x, sizeof(px_t) * objects_count)
+        || !read_bytes(buffer, scene->positions_y, sizeof(px_t) * objects_count)
+        || !read_bytes(buffer, scene->previous_positions_x, sizeof(px_t) * objects_count)
+        || !read_bytes(buffer, scene->previous_positions_y, sizeof(px_t) * objects_count)
+        || !read_bytes(buffer, scene->widths, sizeof(px_t) * objects_count)
+        || !read_bytes(buffer, scene->heights, sizeof(px_t) * objects_count)
+        || !read_bytes(buffer, scene->x_speeds, sizeof(int) * objects_count)
+        || !read_bytes(buffer, scene->y_speeds, sizeof(int) * objects_count)
+        || !read_bytes(buffer, scene->names, MAX_OBJECT_NAME_LENGTH * objects_count)
+        || !read_bytes(buffer, allocator->generations, sizeof(uint16_t) * slots_count)
+        || !read_bytes(buffer, allocator->free_slots, sizeof(ID_slot_t) * free_slots_count)
+        || !read_bytes(buffer, scene->palette, sizeof(colour_t) * slots_count)) {
+        return false;
+    }
+
+    // the slots behind the restored ones are unused, the indices are derived from the IDs of the objects
+    reset_ID_slots(scene);
+    for (int i = 0; i < objects_count; ++i) {
+        ID_slot_t slot = ID_TO_SLOT(scene->IDs[i]);
+        if (!is_ID_alive(scene, scene->IDs[i]) || scene->slot_indices[slot] != -1) {
+            return false;
+        }
+        scene->slot_indices[slot] = i;
+    }
+
+    // a slot in the free list must not be held by an object, nor be in the list twice (it is marked as visited by -2)
+    const int FREE_SLOT_MARK = -2;
+    bool is_valid = true;
+    for (int i = 0; is_valid && i < free_slots_count; ++i) {
+        ID_slot_t slot = allocator->free_slots[i];
+        is_valid = slot != UNDEFINIED_ID && slot < slots_count && scene->slot_indices[slot] == -1;
+        if (is_valid) {
+            scene->slot_indices[slot] = FREE_SLOT_MARK;
+        }
+    }
+    for (int i = 0; i < free_slots_count; ++i) {
+        ID_slot_t slot = allocator->free_slots[i];
+        if (slot < allocator->capacity && scene->slot_indices[slot] == FREE_SLOT_MARK) {
+            scene->slot_indices[slot] = -1;
         }
     }
-    return BLACK;
+
+    return is_valid;
+}
+
+/**
+ * @brief Marks all the slots as not held by any object and resets the slots which have not been taken yet.
+ * 
+ * @param scene The scene.
+ */
+static void reset_ID_slots(scene_t *scene)
+{
+    ID_allocator_t *allocator = &scene->ID_allocator;
+
+    for (int i = 0; i < allocator->capacity; ++i) {
+        scene->slot_indices[i] = -1;
+    }
+    for (int i = allocator->slots_count; i < allocator->capacity; ++i) {
+        allocator->generations[i] = 0;
+        scene->palette[i] = BLACK;
+    }
+}
+
+/**
+ * @brief Maps a slot stored in a pixel buffer to a colour for rendering. The colour is read directly from the palette of the scene.
+ * 
+ * @param scene The scene containing objects.
+ * @param slot The slot of an object ID to map to a colour.
+ * @return The colour corresponding to the given slot (BLACK if no object of the scene holds the slot).
+ */
+static colour_t slot_to_colour(scene_t *scene, ID_slot_t slot)
+{
+    return (slot < scene->ID_allocator.capacity) ? scene->palette[slot] : BLACK;
 }
@@ -17,9 +17,42 @@
 #define DRAW_H
 
 #include <stdbool.h>
+#include <stdint.h>
+
+#include "byte_buffer.h"
+#include "frame.h"
 
 #define UNDEFINIED_ID 0
 
+/**
+ * @brief Number of bits of an object ID holding its slot. The remaining upper bits hold the generation of the slot.
+ */
+#define ID_SLOT_BITS 16
+
+/**
+ * @brief Maximal number of slots of one scene. Slot 0 is reserved for `UNDEFINIED_ID`.
+ */
+#define MAX_ID_SLOTS (1 << ID_SLOT_BITS)
+
+#define ID_TO_SLOT(_ID) ((ID_slot_t)((_ID) & (MAX_ID_SLOTS - 1)))
+#define ID_TO_GENERATION(_ID) ((uint16_t)((_ID) >> ID_SLOT_BITS))
+#define MAKE_ID(_generation, _slot) (((ID_t)(_generation) << ID_SLOT_BITS) | (ID_t)(_slot))
+
+/**
+ * @brief Generation of a slot which has been reused too many times. Such a slot is never handed out again.
+ */
+#define RETIRED_GENERATION UINT16_MAX
+
+/**
+ * @brief Number of collisions the storage of `collisions_t` is first allocated for. It grows when more objects are overlapped.
+ */
+#define INITIAL_COLLISIONS_CAPACITY 8
+
+/**
+ * @brief Maximal length of the name of a scene object, including the terminating zero byte.
+ */
+#define MAX_OBJECT_NAME_LENGTH 32
+
 /**
  * @typedef unsigned int px_t
  * @brief Alias for unsigned integer type used to represent pixel values.
@@ -27,10 +60,20 @@
 typedef unsigned int px_t;
 
 /**
- * @typedef unsigned char ID_t
- * @brief Alias for unsigned char type used to represent object IDs.
+ * @typedef uint32_t ID_t
+ * @brief Alias for the type used to represent object IDs (handles).
+ *
+ * The lower `ID_SLOT_BITS` bits hold the slot of the object in its scene, the upper bits hold the generation
+ * of the slot. Slots are recycled once their objects are removed from the scene, but the generation is increased
+ * every time, so an ID of a removed object never matches the ID of the object reusing its slot.
+ */
+typedef uint32_t ID_t;
+
+/**
+ * @typedef uint16_t ID_slot_t
+ * @brief Alias for the type used to represent the slot part of an object ID. Pixel buffers store only slots.
  */
-typedef unsigned char ID_t;
+typedef uint16_t ID_slot_t;
 
 /**
  * @enum position_t
@@ -80,40 +123,113 @@ typedef enum colour_t {
 typedef struct pixel_buffer_t {
     px_t height;            /** Height of the pixel buffer. */
     px_t width;             /** Width of the pixel buffer. */
-    ID_t* buff;             /** Pointer to the pixel buffer data. */
+    ID_slot_t* buff;        /** Pointer to the pixel buffer data (slots of the object IDs). */
 } pixel_buffer_t;
 
 /**
  * @struct rectangle_t
- * @brief Data structure representing a drawable rectangle object.
+ * @brief Data structure describing a drawable rectangle object.
  *
- * The `rectangle_t` structure defines attributes for a drawable rectangle object.
+ * The `rectangle_t` structure is a plain value describing a rectangle. Objects of a scene are not kept
+ * as rectangles - `add_to_scene()` copies the description into the arrays of the scene.
  * @note In the current state, the library does not support any other objects!
  */
 typedef struct rectangle_t {
-    ID_t ID;                 /** ID of the rectangle object. */
     px_t position_x;         /** Horizontal coordinate of the top-left corner of the rectangle. */
     px_t position_y;         /** Vertical coordinate of the top-left corner of the rectangle. */
-    px_t width;      /** Length of one side of the rectangle. */
-    px_t height;      /** Length of the other side of the rectangle. */
+    px_t width;              /** Length of one side of the rectangle. */
+    px_t height;             /** Length of the other side of the rectangle. */
     int x_speed;             /** X-axis speed of the rectangle. */
     int y_speed;             /** Y-axis speed of the rectangle. */
     colour_t colour;         /** Color of the rectangle. */
-    const char *name;        /** Name identifier of the rectangle. */
+    char name[MAX_OBJECT_NAME_LENGTH]; /** Name identifier of the rectangle. */
 } rectangle_t;
 
+/**
+ * @struct collisions_t
+ * @brief Data structure holding the IDs of the objects overlapped by a rasterized object.
+ */
+typedef struct collisions_t {
+    int count;                   /** Number of stored IDs. */
+    int capacity;                /** Length of the slots array. */
+    ID_slot_t *slots;            /** Slots of the IDs of the overlapped objects, each one stored once. */
+    bool truncated;              /** Whether some overlapped objects are missing because the storage could not grow. */
+} collisions_t;
+
+/**
+ * @struct ID_allocator_t
+ * @brief Data structure handing out the IDs of the objects in a scene.
+ *
+ * Released slots are kept in a free list and reused before new slots are taken. Every slot remembers
+ * its generation, which is increased when the slot is released, so stale IDs can be detected. Slots whose
+ * generation reaches `RETIRED_GENERATION` are retired instead of being wrapped around.
+ */
+typedef struct ID_allocator_t {
+    int slots_count;          /** Number of slots taken so far, including the reserved slot 0. */
+    int capacity;             /** Length of the per-slot arrays. */
+    uint16_t *generations;    /** Current generation of every slot. */
+    ID_slot_t *free_slots;    /** Stack of the released slots. */
+    int free_slots_count;     /** Number of slots in the free list. */
+} ID_allocator_t;
+
 /**
  * @struct scene_t
  * @brief Data structure representing a scene containing multiple drawable objects.
  *
- * The `scene_t` structure defines attributes for a scene containing multiple drawable rectangle objects.
+ * The objects are stored as a structure of arrays: the attributes of the object with index `i` are found
+ * at index `i` of the dense arrays, which hold `number_of_objects` valid entries. Indices change when objects
+ * are removed, so objects are referred to by their IDs and `get_object_index()` maps an ID to its current index.
+ * Colours are kept in the palette indexed by the slots of the IDs, so the renderer can read them directly.
  */
 typedef struct scene_t {
     int number_of_objects;   /** Number of objects in the scene. */
-    int length_of_arr;       /** Length of the objects array. */
-    rectangle_t **scene;     /** Array of rectangle objects representing the scene. */
+    int length_of_arr;       /** Length of the dense arrays. */
+    ID_t *IDs;               /** IDs of the objects. */
+    px_t *positions_x;       /** Horizontal coordinates of the top-left corners of the objects. */
+    px_t *positions_y;       /** Vertical coordinates of the top-left corners of the objects. */
+    px_t *previous_positions_x; /** Horizontal coordinates of the objects saved before the last simulation step. */
+    px_t *previous_positions_y; /** Vertical coordinates of the objects saved before the last simulation step. */
+    px_t *widths;            /** Widths of the objects. */
+    px_t *heights;           /** Heights of the objects. */
+    int *x_speeds;           /** X-axis speeds of the objects. */
+    int *y_speeds;           /** Y-axis speeds of the objects. */
+    char (*names)[MAX_OBJECT_NAME_LENGTH]; /** Name identifiers of the objects. */
+    ID_allocator_t ID_allocator; /** Allocator of the IDs of the objects in the scene. */
+    int *slot_indices;       /** Index of the object holding each slot of the allocator (-1 for unused slots). */
+    colour_t *palette;       /** Colour of every object in the scene indexed by the slot of its ID (BLACK for unused slots). */
 } scene_t;
 
+/**
+ * @struct render_state_t
+ * @brief Data structure describing what is currently shown on the terminal canvas.
+ *
+ * The `render_state_t` structure remembers the colour of every cell sent to the terminal by the last
+ * call of `render_graphics()`. The next frame then sends only the cells whose colour has changed.
+ */
+typedef struct render_state_t {
+    px_t height;                        /** Height of the rendered area. */
+    px_t width;                         /** Width of the rendered area. */
+    colour_t *screen;                   /** Colours of the cells currently shown on the terminal. */
+    const char **column_backgrounds;    /** Glyph shown under the empty cells of each column (NULL means a blank cell). */
+    bool full_repaint;                  /** Whether the next frame has to be painted from scratch. */
+    int resize_generation;              /** Number of terminal resizes seen when the screen was last painted. */
+} render_state_t;
+
+/**
+ * @brief Starts a new frame. Until `end_frame()` is called, all drawing functions of this file append their output
+ *        into the given frame buffer instead of printing it.
+ * 
+ * @param frame The frame buffer to collect the output in. Its previous content is discarded.
+ */
+void begin_frame(frame_buffer_t *frame);
+
+/**
+ * @brief Finishes the frame started by `begin_frame()` and sends it to the terminal with a single write.
+ * 
+ * @return 0 on success (or if no frame was started), -1 on failure.
+ */
+int end_frame(void);
+
 /**
  * @brief Clears the terminal screen by sending escape codes.
  */
@@ -140,13 +256,19 @@ void show_cursor(void);
 void hide_cursor(void);
 
 /**
- * @brief Draws borders around the terminal canvas.
+ * @brief Draws borders around the terminal canvas. The bytes of the borders are built once for each canvas size
+ *        and then reused from the cache.
  * 
  * @param height The height of the canvas.
  * @param width The width of the canvas.
  */
 void draw_borders(px_t height, px_t width);
 
+/**
+ * @brief Releases memory allocated for the cached borders.
+ */
+void release_border_cache(void);
+
 /**
  * @brief Puts text on the terminal with alignment options.
  * 
@@ -164,6 +286,14 @@ void put_text(const char* text, px_t line_width, position_t pos);
  */
 void write_text(const char* format, ...);
 
+/**
+ * @brief Writes formatted text to the terminal at the current cursor position.
+ * 
+ * @param format The format string for the text.
+ * @param ... Additional arguments for formatting.
+ */
+void write_raw_text(const char* format, ...);
+
 /**
  * @brief Puts a button on the terminal with alignment options.
  * 
@@ -209,6 +339,27 @@ const char* colour_2_string(colour_t colour);
  */
 pixel_buffer_t *create_pixel_buffer(px_t height, px_t width);
 
+/**
+ * @brief Appends the whole state of the scene to the buffer: the objects, the generations of the IDs, the free list
+ *        and the palette. The data is stored in the native layout (see byte_buffer.h).
+ *
+ * @param scene The scene.
+ * @param buffer The buffer to write to.
+ * @return true on success, false if the memory allocation failed.
+ */
+bool write_scene(scene_t *scene, byte_buffer_t *buffer);
+
+/**
+ * @brief Replaces the state of the scene with a state written by `write_scene()`. The IDs stay the same, so IDs
+ *        saved together with the scene are valid in the restored scene. The arrays of the scene are reused
+ *        and grow only if the restored scene is bigger.
+ *
+ * @param scene The scene to restore.
+ * @param buffer The buffer to read from.
+ * @return true on success, false on invalid data or failure (the scene is left empty then, but valid).
+ */
+bool read_scene(scene_t *scene, byte_buffer_t *buffer);
+
 /**
  * @brief Releases memory allocated for a scene and its objects.
  * 
@@ -219,20 +370,101 @@ void release_pixel_buffer(pixel_buffer_t *pixel_buffer);
 /**
  * @brief Renders graphics on a pixel buffer using a scene.
  *        Each pixel contains ID of the object and each object has its color.
+ *        Only the cells whose colour differs from the one shown on the terminal are sent. On a full repaint
+ *        the canvas is expected to be blank (e.g. freshly drawn by `draw_borders()`).
  * 
  * @param pixel_buffer The pixel buffer to render on.
  * @param scene The scene containing objects to be rendered.
+ * @param render_state The state of the terminal canvas, updated to the rendered frame.
+ */
+void render_graphics(pixel_buffer_t *pixel_buffer, scene_t *scene, render_state_t *render_state);
+
+/**
+ * @brief Creates a render state for a canvas with a given height and width. The first frame rendered
+ *        with the new state is always a full repaint.
+ * 
+ * @param height The height of the rendered area.
+ * @param width The width of the rendered area.
+ * @return A pointer to the created render state, or NULL on failure.
+ */
+render_state_t *create_render_state(px_t height, px_t width);
+
+/**
+ * @brief Sets the glyph which is shown under the empty cells of a column, e.g. a border overlapping the canvas.
+ *        Cells of the column which become empty are restored to this glyph instead of being blanked.
+ * 
+ * @param render_state The render state to modify.
+ * @param column The column of the canvas.
+ * @param glyph The glyph to show under the empty cells (it must outlive the render state), or NULL for a blank cell.
  */
-void render_graphics(pixel_buffer_t *pixel_buffer, scene_t *scene);
+void set_render_state_column_background(render_state_t *render_state, px_t column, const char *glyph);
+
+/**
+ * @brief Forces the next frame rendered with the given state to be a full repaint.
+ * 
+ * @param render_state The render state to invalidate.
+ */
+void invalidate_render_state(render_state_t *render_state);
+
+/**
+ * @brief Marks that the terminal window has been resized, so all the render states repaint their canvas from scratch.
+ *        Resizes are detected by a SIGWINCH handler, but applications receiving SIGWINCH in another way
+ *        (e.g. through an event loop, where the signal is blocked) have to report them by this function.
+ */
+void notify_terminal_resize(void);
+
+/**
+ * @brief Checks whether the next frame has to be painted from scratch. This happens for the first frame,
+ *        after `invalidate_render_state()` and after the terminal window has been resized.
+ * 
+ * @param render_state The render state to check.
+ * @return true if the canvas has to be cleared and repainted, false otherwise.
+ */
+bool render_state_needs_full_repaint(render_state_t *render_state);
+
+/**
+ * @brief Releases memory allocated for a render state.
+ * 
+ * @param render_state The render state to release.
+ */
+void release_render_state(render_state_t *render_state);
 
 /**
  * @brief Computes and assigns pixel IDs in the pixel buffer for a given object.
+ *        The object is clipped against the buffer. Pixels already occupied by other objects are kept
+ *        and the IDs of these objects are reported as collisions.
  * 
  * @param pixel_buffer The pixel buffer to compute IDs in.
- * @param object The object for which to compute pixel IDs.
- * @return The assigned ID for the object.
+ * @param scene The scene holding the object.
+ * @param object The ID of the object for which to compute pixel IDs.
+ * @param collisions The structure filled with the slots of the IDs of the overlapped objects (initialized by `init_collisions()`),
+ *                   or NULL if they are not needed. Its previous content is discarded.
+ * @return The number of distinct objects the object overlaps. It exceeds `collisions->count` only if the collisions are truncated.
+ */
+int compute_object_pixels_in_buffer(pixel_buffer_t *pixel_buffer, scene_t *scene, ID_t object, collisions_t *collisions);
+
+/**
+ * @brief Initializes an empty collisions structure. The storage is allocated when the first collision is stored.
+ * 
+ * @param collisions The collisions to initialize.
+ */
+void init_collisions(collisions_t *collisions);
+
+/**
+ * @brief Releases the storage of a collisions structure. The structure itself is not freed.
+ * 
+ * @param collisions The collisions to release.
+ */
+void release_collisions(collisions_t *collisions);
+
+/**
+ * @brief Checks whether an object with the given ID is among the collisions.
+ * 
+ * @param collisions The collisions to search, or NULL.
+ * @param ID The ID of the object.
+ * @return true if the object collided, false otherwise.
  */
-ID_t compute_object_pixels_in_buffer(pixel_buffer_t *pixel_buffer, rectangle_t *object);
+bool collisions_contain(collisions_t *collisions, ID_t ID);
 
 /**
  * @brief Clears the pixels occupied by an object in a pixel buffer.
@@ -241,9 +473,21 @@ ID_t compute_object_pixels_in_buffer(pixel_buffer_t *pixel_buffer, rectangle_t *
  * their values to `UNDEFINED_ID`.
  *
  * @param pixel_buffer Pointer to the pixel buffer where the pixels are stored.
- * @param object Pointer to the rectangle representing the object's position and dimensions.
+ * @param scene The scene holding the object.
+ * @param object The ID of the object whose pixels are cleared.
+ */
+void clear_object_pixels_in_buffer(pixel_buffer_t *pixel_buffer, scene_t *scene, ID_t object);
+
+/**
+ * @brief Computes pixel IDs of all the objects of the scene at positions interpolated between the positions saved by
+ *        `save_scene_positions()` and the current positions. The buffer is reset first. This is meant for rendering
+ *        between two simulation steps, the collisions are not reported (objects drawn earlier keep the overlapped pixels).
+ *
+ * @param pixel_buffer The pixel buffer to compute IDs in.
+ * @param scene The scene holding the objects.
+ * @param alpha The interpolation factor between 0 (previous positions) and 1 (current positions).
  */
-void clear_object_pixels_in_buffer(pixel_buffer_t *pixel_buffer, rectangle_t *object);
+void compute_interpolated_scene_pixels_in_buffer(pixel_buffer_t *pixel_buffer, scene_t *scene, double alpha);
 
 /**
  * @brief Resets the pixel buffer by clearing assigned pixel IDs.
@@ -253,7 +497,7 @@ void clear_object_pixels_in_buffer(pixel_buffer_t *pixel_buffer, rectangle_t *ob
 void reset_pixel_buffer(pixel_buffer_t *pixel_buffer);
 
 /**
- * @brief Creates a rectangle object with specified attributes.
+ * @brief Creates a description of a rectangle object with specified attributes.
  * 
  * @param position_x The X position of the rectangle.
  * @param position_y The Y position of the rectangle.
@@ -262,17 +506,10 @@ void reset_pixel_buffer(pixel_buffer_t *pixel_buffer);
  * @param x_speed The speed of the rectangle along the X-axis.
  * @param y_speed The speed of the rectangle along the Y-axis.
  * @param colour The color of the rectangle.
- * @param name The name of the rectangle.
- * @return A pointer to the created rectangle object.
+ * @param name The name of the rectangle (longer names are truncated to `MAX_OBJECT_NAME_LENGTH - 1` characters).
+ * @return The rectangle description.
  */
-rectangle_t *create_rectangle(px_t position_x, px_t position_y, px_t width, px_t height, int x_speed, int y_speed, colour_t colour, const char *name);
-
-/**
- * @brief Releases memory allocated for a rectangle object.
- * 
- * @param rectangle The rectangle object to release.
- */
-void release_rectangle(rectangle_t *rectangle);
+rectangle_t create_rectangle(px_t position_x, px_t position_y, px_t width, px_t height, int x_speed, int y_speed, colour_t colour, const char *name);
 
 /**
  * @brief Creates a scene for managing objects.
@@ -282,22 +519,88 @@ void release_rectangle(rectangle_t *rectangle);
 scene_t *create_scene();
 
 /**
- * @brief Adds an object to a scene.
+ * @brief Adds an object to a scene. The description is copied into the scene and the object gets a new ID.
  * 
  * @param scene The scene to which the object will be added.
- * @param object The object to be added.
- * @return A pointer to the added object.
+ * @param object The description of the object to be added.
+ * @return The ID of the added object, or UNDEFINIED_ID on failure (e.g. no free ID is left).
  */
-rectangle_t *add_to_scene(scene_t *scene, rectangle_t *object);
+ID_t add_to_scene(scene_t *scene, const rectangle_t *object);
 
 /**
- * @brief Removes an object from a scene.
+ * @brief Removes an object from a scene. The ID of the object is released and becomes stale.
+ *        By default the last object of the scene is moved to the freed index, which takes constant time.
+ *        If the order of the objects matters, all the following objects are moved one index down instead.
  * 
  * @param scene The scene from which the object will be removed.
- * @param object The object to be removed.
- * @return A pointer to the removed object.
+ * @param object The ID of the object to be removed.
+ * @param keep_order Whether the order of the remaining objects has to be kept.
+ * @return true if the object was removed, false if the ID is not alive in the scene.
+ */
+bool remove_object_from_scene(scene_t *scene, ID_t object, bool keep_order);
+
+/**
+ * @brief Finds an object of the scene by its name. The search compares the names of all the objects,
+ *        so it is meant for debugging and tooling - the objects should be referred to by their IDs.
+ * 
+ * @param scene The scene.
+ * @param name The name of the object.
+ * @return The ID of the first object with the name, or UNDEFINIED_ID if there is no such object.
+ */
+ID_t find_object_by_name(scene_t *scene, const char *name);
+
+/**
+ * @brief Maps the ID of an object to its current index in the arrays of the scene.
+ * 
+ * @param scene The scene.
+ * @param ID The ID of the object.
+ * @return The index of the object, or -1 if the ID is not alive in the scene.
+ */
+int get_object_index(scene_t *scene, ID_t ID);
+
+/**
+ * @brief Checks whether the ID belongs to an object which is currently in the scene.
+ * 
+ * @param scene The scene.
+ * @param ID The ID to check.
+ * @return true if the ID is alive, false if it is undefined or its object has been removed.
+ */
+bool is_ID_alive(scene_t *scene, ID_t ID);
+
+/**
+ * @brief Sets the colour of an object in the palette of the scene.
+ * 
+ * @param scene The scene holding the object.
+ * @param object The ID of the object to recolour.
+ * @param colour The new colour.
+ */
+void set_object_colour(scene_t *scene, ID_t object, colour_t colour);
+
+/**
+ * @brief Gets the colour of an object from the palette of the scene.
+ * 
+ * @param scene The scene holding the object.
+ * @param object The ID of the object.
+ * @return The colour of the object (BLACK if the ID is not alive in the scene).
+ */
+colour_t get_object_colour(scene_t *scene, ID_t object);
+
+/**
+ * @brief Saves the current positions of all the objects of the scene as their previous positions.
+ *        It is called before every simulation step, so the rendering can interpolate between the last two steps.
+ *
+ * @param scene The scene.
+ */
+void save_scene_positions(scene_t *scene);
+
+/**
+ * @brief Makes the previous position of an object equal to its current position, so the object is not interpolated
+ *        until the next simulation step. It is used for objects which are teleported, not moved.
+ *
+ * @param scene The scene holding the object.
+ * @param object The ID of the object.
  */
-rectangle_t *remove_object_from_scene(scene_t *scene, rectangle_t *object);
+void reset_object_interpolation(scene_t *scene, ID_t object);
 
 /**
  * @brief Releases memory allocated for a scene and its objects.
@@ -0,0 +1,396 @@
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/signalfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+#include "event_loop.h"
+#include "log.h"
+
+// ---------------------------------------- MACROS --------------------------------------------- //
+
+#define MAX_EPOLL_EVENTS 8
+
+// ---------------------------------- STATIC DECLARATIONS--------------------------------------- //
+
+static bool watch_file_descriptor(event_loop_t *loop, int file_descriptor);
+static bool is_file_descriptor_watched(event_loop_t *loop, int file_descriptor);
+static bool push_event_source(event_loop_t *loop, event_source_t source);
+static void remove_event_source_at(event_loop_t *loop, int index);
+static event_source_t *find_latest_source(event_loop_t *loop, event_source_type_t type, int file_descriptor, int signal_number);
+static bool update_signal_file_descriptor(event_loop_t *loop);
+static void dispatch_signals(event_loop_t *loop);
+static void dispatch_file_descriptor(event_loop_t *loop, int file_descriptor);
+
+// ----------------------------------------- PROGRAM-------------------------------------------- //
+
+event_loop_t *create_event_loop(void)
+{
+    event_loop_t *loop = malloc(sizeof(event_loop_t));
+    if (loop == NULL) {
+        resolve_error(MEM_ALOC_FAILURE, NULL);
+        return NULL;
+    }
+
+    loop->epoll_file_descriptor = epoll_create1(EPOLL_CLOEXEC);
+    if (loop->epoll_file_descriptor == -1) {
+        resolve_error(GENERAL_IO_ERROR, "invalid operation with function \'epoll_create1()\'.");
+        free(loop);
+        return NULL;
+    }
+
+    loop->signal_file_descriptor = -1;
+    sigemptyset(&loop->signals);
+    loop->sources_count = 0;
+    loop->running_depth = 0;
+    loop->stop_depth = 0;
+    loop->quitting = false;
+
+    return loop;
+}
+
+bool add_event_source(event_loop_t *loop, int file_descriptor, event_handler_t handler, void *context)
+{
+    event_source_t source = { FILE_DESCRIPTOR_SOURCE, file_descriptor, 0, handler, context };
+
+    if (!is_file_descriptor_watched(loop, file_descriptor) && !watch_file_descriptor(loop, file_descriptor)) {
+        return false;
+    }
+
+    if (!push_event_source(loop, source)) {
+        if (!is_file_descriptor_watched(loop, file_descriptor)) {
+            (void)epoll_ctl(loop->epoll_file_descriptor, EPOLL_CTL_DEL, file_descriptor, NULL);
+        }
+        return false;
+    }
+
+    return true;
+}
+
+void remove_event_source(event_loop_t *loop, int file_descriptor)
+{
+    event_source_t *source = find_latest_source(loop, FILE_DESCRIPTOR_SOURCE, file_descriptor, 0);
+    if (source == NULL) {
+        return;
+    }
+
+    remove_event_source_at(loop, (int)(source - loop->sources));
+
+    if (!is_file_descriptor_watched(loop, file_descriptor)) {
+        (void)epoll_ctl(loop->epoll_file_descriptor, EPOLL_CTL_DEL, file_descriptor, NULL);
+    }
+}
+
+int add_timer_source(event_loop_t *loop, nanoseconds_t period, event_handler_t handler, void *context)
+{
+    int timer = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (timer == -1) {
+        resolve_error(GENERAL_IO_ERROR, "invalid operation with function \'timerfd_create()\'.");
+        return -1;
+    }
+
+    struct itimerspec specification;
+    specification.it_interval.tv_sec = period / NANOSECONDS_IN_SECOND;
+    specification.it_interval.tv_nsec = period % NANOSECONDS_IN_SECOND;
+    specification.it_value = specification.it_interval;
+
+    event_source_t source = { TIMER_SOURCE, timer, 0, handler, context };
+
+    if (timerfd_settime(timer, 0, &specification, NULL) == -1) {
+        resolve_error(GENERAL_IO_ERROR, "invalid operation with function \'timerfd_settime()\'.");
+        close(timer);
+        return -1;
+    }
+
+    if (!watch_file_descriptor(loop, timer)) {
+        close(timer);
+        return -1;
+    }
+
+    if (!push_event_source(loop, source)) {
+        (void)epoll_ctl(loop->epoll_file_descriptor, EPOLL_CTL_DEL, timer, NULL);
+        close(timer);
+        return -1;
+    }
+
+    return timer;
+}
+
+void remove_timer_source(event_loop_t *loop, int timer)
+{
+    event_source_t *source = find_latest_source(loop, TIMER_SOURCE, timer, 0);
+    if (source == NULL) {
+        return;
+    }
+
+    remove_event_source_at(loop, (int)(source - loop->sources));
+    (void)epoll_ctl(loop->epoll_file_descriptor, EPOLL_CTL_DEL, timer, NULL);
+    close(timer);
+}
+
+bool add_signal_source(event_loop_t *loop, int signal_number, event_handler_t handler, void *context)
+{
+    event_source_t source = { SIGNAL_SOURCE, -1, signal_number, handler, context };
+
+    if (!push_event_source(loop, source)) {
+        return false;
+    }
+
+    if (!sigismember(&loop->signals, signal_number)) {
+        sigaddset(&loop->signals, signal_number);
+        if (!update_signal_file_descriptor(loop)) {
+            sigdelset(&loop->signals, signal_number);
+            remove_event_source_at(loop, loop->sources_count - 1);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void remove_signal_source(event_loop_t *loop, int signal_number)
+{
+    event_source_t *source = find_latest_source(loop, SIGNAL_SOURCE, -1, signal_number);
+    if (source != NULL) {
+        remove_event_source_at(loop, (int)(source - loop->sources));
+    }
+}
+
+int run_event_loop(event_loop_t *loop)
+{
+    int depth = ++loop->running_depth;
+    int return_code = 0;
+
+    while (!loop->quitting && loop->stop_depth != depth) {
+
+        struct epoll_event events[MAX_EPOLL_EVENTS];
+        int count = epoll_wait(loop->epoll_file_descriptor, events, MAX_EPOLL_EVENTS, -1);
+
+        if (count == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            resolve_error(GENERAL_IO_ERROR, "invalid operation with function \'epoll_wait()\'.");
+            return_code = -1;
+            break;
+        }
+
+        // a handler may stop the run or remove other sources, so the conditions are checked before every dispatch
+        for (int i = 0; i < count && !loop->quitting && loop->stop_depth != depth; ++i) {
+            if (events[i].data.fd == loop->signal_file_descriptor) {
+                dispatch_signals(loop);
+            } else {
+                dispatch_file_descriptor(loop, events[i].data.fd);
+            }
+        }
+    }
+
+    if (loop->stop_depth == depth) {
+        loop->stop_depth = 0;
+    }
+    loop->running_depth--;
+
+    return return_code;
+}
+
+void stop_event_loop(event_loop_t *loop)
+{
+    loop->stop_depth = loop->running_depth;
+}
+
+void quit_event_loop(event_loop_t *loop)
+{
+    loop->quitting = true;
+}
+
+bool is_event_loop_quitting(event_loop_t *loop)
+{
+    return loop->quitting;
+}
+
+void release_event_loop(event_loop_t *loop)
+{
+    if (loop == NULL) {
+        return;
+    }
+
+    for (int i = 0; i < loop->sources_count; ++i) {
+        if (loop->sources[i].type == TIMER_SOURCE) {
+            close(loop->sources[i].file_descriptor);
+        }
+    }
+
+    if (loop->signal_file_descriptor != -1) {
+        close(loop->signal_file_descriptor);
+        sigprocmask(SIG_UNBLOCK, &loop->signals, NULL);
+    }
+
+    close(loop->epoll_file_descriptor);
+    free(loop);
+}
+
+/**
+ * @brief Adds the file descriptor into the epoll instance of the loop.
+ *
+ * @param loop The event loop.
+ * @param file_descriptor The file descriptor to watch for reading.
+ * @return true on success, false on failure.
+ */
+static bool watch_file_descriptor(event_loop_t *loop, int file_descriptor)
+{
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.fd = file_descriptor;
+
+    if (epoll_ctl(loop->epoll_file_descriptor, EPOLL_CTL_ADD, file_descriptor, &event) == -1) {
+        resolve_error(GENERAL_IO_ERROR, "invalid operation with function \'epoll_ctl()\'.");
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Checks whether any source of the loop watches the file descriptor.
+ *
+ * @param loop The event loop.
+ * @param file_descriptor The file descriptor.
+ * @return true if the file descriptor is watched, false otherwise.
+ */
+static bool is_file_descriptor_watched(event_loop_t *loop, int file_descriptor)
+{
+    for (int i = 0; i < loop->sources_count; ++i) {
+        if (loop->sources[i].type != SIGNAL_SOURCE && loop->sources[i].file_descriptor == file_descriptor) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Appends the source at the end of the sources of the loop.
+ *
+ * @param loop The event loop.
+ * @param source The source to append.
+ * @return true on success, false if there are already MAX_EVENT_SOURCES sources.
+ */
+static bool push_event_source(event_loop_t *loop, event_source_t source)
+{
+    if (loop->sources_count >= MAX_EVENT_SOURCES) {
+        resolve_error(GENERAL_ERROR, "too many sources of the event loop.");
+        return false;
+    }
+
+    loop->sources[loop->sources_count++] = source;
+    return true;
+}
+
+/**
+ * @brief Removes a source of the loop. The order of the remaining sources is kept.
+ *
+ * @param loop The event loop.
+ * @param index The index of the removed source.
+ */
+static void remove_event_source_at(event_loop_t *loop, int index)
+{
+    memmove(&loop->sources[index], &loop->sources[index + 1], sizeof(event_source_t) * (loop->sources_count - index - 1));
+    loop->sources_count--;
+}
+
+/**
+ * @brief Finds the source registered last for the file descriptor (or for the signal, in case of signal sources).
+ *
+ * @param loop The event loop.
+ * @param type The type of the source.
+ * @param file_descriptor The watched file descriptor (ignored for signal sources).
+ * @param signal_number The watched signal (ignored for other sources).
+ * @return A pointer to the source, or NULL if there is none.
+ */
+static event_source_t *find_latest_source(event_loop_t *loop, event_source_type_t type, int file_descriptor, int signal_number)
+{
+    for (int i = loop->sources_count - 1; i >= 0; --i) {
+        event_source_t *source = &loop->sources[i];
+        if (source->type != type) {
+            continue;
+        }
+        if ((type == SIGNAL_SOURCE && source->signal_number == signal_number) ||
+            (type != SIGNAL_SOURCE && source->file_descriptor == file_descriptor)) {
+            return source;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Blocks the watched signals and makes the signalfd of the loop receive all of them.
+ *        The signalfd is created (and added into the epoll instance) when the first signal is watched.
+ *
+ * @param loop The event loop.
+ * @return true on success, false on failure.
+ */
+static bool update_signal_file_descriptor(event_loop_t *loop)
+{
+    if (sigprocmask(SIG_BLOCK, &loop->signals, NULL) == -1) {
+        resolve_error(GENERAL_ERROR, "invalid operation with function \'sigprocmask()\'.");
+        return false;
+    }
+
+    int file_descriptor = signalfd(loop->signal_file_descriptor, &loop->signals, SFD_NONBLOCK | SFD_CLOEXEC);
+    if (file_descriptor == -1) {
+        resolve_error(GENERAL_IO_ERROR, "invalid operation with function \'signalfd()\'.");
+        return false;
+    }
+
+    if (loop->signal_file_descriptor == -1) {
+        if (!watch_file_descriptor(loop, file_descriptor)) {
+            close(file_descriptor);
+            return false;
+        }
+        loop->signal_file_descriptor = file_descriptor;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Reads all the pending signals from the signalfd and calls their latest handlers.
+ *
+ * @param loop The event loop.
+ */
+static void dispatch_signals(event_loop_t *loop)
+{
+    struct signalfd_siginfo information;
+
+    while (read(loop->signal_file_descriptor, &information, sizeof(information)) == sizeof(information)) {
+        event_source_t *source = find_latest_source(loop, SIGNAL_SOURCE, -1, (int)information.ssi_signo);
+        if (source != NULL) {
+            source->handler(loop, source->context);
+        }
+    }
+}
+
+/**
+ * @brief Calls the latest handler of a readable file descriptor. The expirations of timers are consumed first.
+ *
+ * @param loop The event loop.
+ * @param file_descriptor The readable file descriptor.
+ */
+static void dispatch_file_descriptor(event_loop_t *loop, int file_descriptor)
+{
+    event_source_t *source = find_latest_source(loop, TIMER_SOURCE, file_descriptor, 0);
+    if (source != NULL) {
+        uint64_t expirations;
+        if (read(file_descriptor, &expirations, sizeof(expirations)) != sizeof(expirations)) {
+            return;
+        }
+    } else {
+        source = find_latest_source(loop, FILE_DESCRIPTOR_SOURCE, file_descriptor, 0);
+    }
+
+    if (source != NULL) {
+        source->handler(loop, source->context);
+    }
+}
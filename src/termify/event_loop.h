@@ -0,0 +1,179 @@
+/**
+ * @file event_loop.h
+ * @author Marek Eibel
+ * @brief Header file containing the event loop driving the whole application.
+ *
+ * The event loop waits in `epoll_wait()` for file descriptors, timers (`timerfd`) and signals (`signalfd`), and calls
+ * the handlers registered for them. Without any timer the loop sleeps until something happens, so idle pages cause
+ * no wakeups at all.
+ *
+ * Registrations behave like a stack: if several handlers are registered for the same file descriptor or signal,
+ * only the one registered last is called. A page can therefore take over the keyboard while it is shown and give it
+ * back by removing its handler. The loop can also be run again from inside a handler (a nested run); `stop_event_loop()`
+ * ends the innermost run, while `quit_event_loop()` ends all of them.
+ *
+ * @version 0.1
+ * @date 2023-09-29
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef EVENT_LOOP_H
+#define EVENT_LOOP_H
+
+#include <signal.h>
+#include <stdbool.h>
+
+#include "clock.h"
+
+#define MAX_EVENT_SOURCES 16
+
+typedef struct event_loop_t event_loop_t;
+
+/**
+ * @typedef event_handler_t
+ * @brief Function called by the event loop when its source is ready.
+ */
+typedef void (*event_handler_t)(event_loop_t *loop, void *context);
+
+/**
+ * @brief Represents the kinds of sources the event loop can wait for.
+ */
+typedef enum event_source_type_t {
+    FILE_DESCRIPTOR_SOURCE,  /** The handler is called when the file descriptor is readable. */
+    TIMER_SOURCE,            /** The handler is called once per timer period (missed periods are merged into one call). */
+    SIGNAL_SOURCE            /** The handler is called when the signal arrives. */
+} event_source_type_t;
+
+/**
+ * @struct event_source_t
+ * @brief Data structure representing one registered handler of the event loop.
+ */
+typedef struct event_source_t {
+    event_source_type_t type;    /** Kind of the source. */
+    int file_descriptor;         /** Watched file descriptor (the timerfd for timers, unused for signals). */
+    int signal_number;           /** Watched signal (only for signals). */
+    event_handler_t handler;     /** Function called when the source is ready. */
+    void *context;               /** Pointer passed to the handler. */
+} event_source_t;
+
+/**
+ * @struct event_loop_t
+ * @brief Data structure representing the event loop.
+ */
+struct event_loop_t {
+    int epoll_file_descriptor;                  /** The epoll instance. */
+    int signal_file_descriptor;                 /** The signalfd receiving all the watched signals (-1 if there is none). */
+    sigset_t signals;                           /** Set of the watched signals (they are blocked for normal delivery). */
+    event_source_t sources[MAX_EVENT_SOURCES];  /** Registered sources in the order of registration. */
+    int sources_count;                          /** Number of registered sources. */
+    int running_depth;                          /** Number of runs of the loop currently in progress. */
+    int stop_depth;                             /** Depth of the run which has to stop (0 if none has to). */
+    bool quitting;                              /** Whether all the runs have to stop. */
+};
+
+/**
+ * @brief Creates an event loop without any sources.
+ *
+ * @return A pointer to the created event loop, or NULL on failure.
+ */
+event_loop_t *create_event_loop(void);
+
+/**
+ * @brief Registers a handler called whenever the file descriptor is readable.
+ *
+ * @param loop The event loop.
+ * @param file_descriptor The file descriptor to watch.
+ * @param handler The function to call.
+ * @param context The pointer passed to the handler.
+ * @return true on success, false on failure.
+ */
+bool add_event_source(event_loop_t *loop, int file_descriptor, event_handler_t handler, void *context);
+
+/**
+ * @brief Removes the handler registered last for the file descriptor. The previous handler (if any) takes over.
+ *
+ * @param loop The event loop.
+ * @param file_descriptor The watched file descriptor.
+ */
+void remove_event_source(event_loop_t *loop, int file_descriptor);
+
+/**
+ * @brief Creates a periodic timer and registers a handler called on every period. The first period starts now.
+ *
+ * @param loop The event loop.
+ * @param period The period of the timer.
+ * @param handler The function to call.
+ * @param context The pointer passed to the handler.
+ * @return The file descriptor identifying the timer, or -1 on failure.
+ */
+int add_timer_source(event_loop_t *loop, nanoseconds_t period, event_handler_t handler, void *context);
+
+/**
+ * @brief Removes a timer created by `add_timer_source()` and closes it.
+ *
+ * @param loop The event loop.
+ * @param timer The file descriptor identifying the timer.
+ */
+void remove_timer_source(event_loop_t *loop, int timer);
+
+/**
+ * @brief Registers a handler called whenever the signal arrives. The signal is blocked and received through the loop,
+ *        so the handler can do anything a normal function can.
+ *
+ * @param loop The event loop.
+ * @param signal_number The signal to watch.
+ * @param handler The function to call.
+ * @param context The pointer passed to the handler.
+ * @return true on success, false on failure.
+ */
+bool add_signal_source(event_loop_t *loop, int signal_number, event_handler_t handler, void *context);
+
+/**
+ * @brief Removes the handler registered last for the signal. The previous handler (if any) takes over.
+ *        The signal stays blocked.
+ *
+ * @param loop The event loop.
+ * @param signal_number The watched signal.
+ */
+void remove_signal_source(event_loop_t *loop, int signal_number);
+
+/**
+ * @brief Waits for the sources and calls their handlers until the run is stopped.
+ *
+ * @param loop The event loop.
+ * @return 0 if the run was stopped, -1 on failure.
+ */
+int run_event_loop(event_loop_t *loop);
+
+/**
+ * @brief Stops the innermost run of the event loop once the current handler returns.
+ *
+ * @param loop The event loop.
+ */
+void stop_event_loop(event_loop_t *loop);
+
+/**
+ * @brief Stops all the runs of the event loop, including those which start later.
+ *
+ * @param loop The event loop.
+ */
+void quit_event_loop(event_loop_t *loop);
+
+/**
+ * @brief Checks whether `quit_event_loop()` was called.
+ *
+ * @param loop The event loop.
+ * @return true if the application is quitting, false otherwise.
+ */
+bool is_event_loop_quitting(event_loop_t *loop);
+
+/**
+ * @brief Releases the event loop and closes its timers. The watched signals are unblocked again.
+ *
+ * @param loop The event loop.
+ */
+void release_event_loop(event_loop_t *loop);
+
+#endif
@@ -0,0 +1,138 @@
+#include <errno.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "frame.h"
+#include "log.h"
+
+// ---------------------------------- STATIC DECLARATIONS--------------------------------------- //
+
+static bool reserve_frame_buffer(frame_buffer_t *frame, size_t length);
+
+// ----------------------------------------- PROGRAM-------------------------------------------- //
+
+frame_buffer_t *create_frame_buffer(size_t capacity)
+{
+    frame_buffer_t *frame = malloc(sizeof(frame_buffer_t));
+    if (frame == NULL) {
+        resolve_error(MEM_ALOC_FAILURE, NULL);
+        return NULL;
+    }
+
+    frame->length = 0;
+    frame->capacity = (capacity == 0) ? 1 : capacity;
+    frame->data = malloc(frame->capacity);
+
+    if (frame->data == NULL) {
+        resolve_error(MEM_ALOC_FAILURE, NULL);
+        free(frame);
+        return NULL;
+    }
+
+    return frame;
+}
+
+bool append_to_frame_buffer(frame_buffer_t *frame, const char *bytes, size_t length)
+{
+    if (!reserve_frame_buffer(frame, length)) {
+        return false;
+    }
+
+    memcpy(frame->data + frame->length, bytes, length);
+    frame->length += length;
+    return true;
+}
+
+bool append_formatted_to_frame_buffer(frame_buffer_t *frame, const char *format, va_list args)
+{
+    va_list args_copy;
+    va_copy(args_copy, args);
+
+    size_t free_space = frame->capacity - frame->length;
+    int size = vsnprintf(frame->data + frame->length, free_space, format, args_copy);
+    va_end(args_copy);
+
+    if (size < 0) {
+        resolve_error(GENERAL_IO_ERROR, "invalid operation with function \'vsnprintf()\'.");
+        return false;
+    }
+
+    // the text did not fit (there has to be space for the terminating zero byte written by vsnprintf)
+    if ((size_t)size >= free_space) {
+        if (!reserve_frame_buffer(frame, size + 1)) {
+            return false;
+        }
+        vsnprintf(frame->data + frame->length, size + 1, format, args);
+    }
+
+    frame->length += size;
+    return true;
+}
+
+int write_frame_buffer(frame_buffer_t *frame, int file_descriptor)
+{
+    size_t written = 0;
+    while (written < frame->length) {
+        ssize_t bytes = write(file_descriptor, frame->data + written, frame->length - written);
+        if (bytes == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            resolve_error(GENERAL_IO_ERROR, "invalid operation with function \'write()\'.");
+            frame->length = 0;
+            return -1;
+        }
+        written += bytes;
+    }
+
+    frame->length = 0;
+    return 0;
+}
+
+void clear_frame_buffer(frame_buffer_t *frame)
+{
+    frame->length = 0;
+}
+
+void release_frame_buffer(frame_buffer_t *frame)
+{
+    if (frame != NULL) {
+        free(frame->data);
+        free(frame);
+    }
+}
+
+/**
+ * @brief Makes sure there is space for at least <length> more bytes in the frame buffer.
+ *
+ * @param frame The frame buffer.
+ * @param length The number of bytes which are going to be appended.
+ * @return true on success, false if the memory allocation failed.
+ */
+static bool reserve_frame_buffer(frame_buffer_t *frame, size_t length)
+{
+    const int GROWTH_FACTOR = 2;
+
+    if (frame->length + length <= frame->capacity) {
+        return true;
+    }
+
+    size_t new_capacity = frame->capacity;
+    while (frame->length + length > new_capacity) {
+        new_capacity *= GROWTH_FACTOR;
+    }
+
+    char *new_data = realloc(frame->data, new_capacity);
+    if (new_data == NULL) {
+        resolve_error(MEM_ALOC_FAILURE, NULL);
+        return false;
+    }
+
+    frame->data = new_data;
+    frame->capacity = new_capacity;
+    return true;
+}
@@ -0,0 +1,86 @@
+/**
+ * @file frame.h
+ * @author Marek Eibel
+ * @brief Header file containing the frame buffer used for collecting the terminal output of one frame.
+ *
+ * The frame buffer is a growable byte buffer. All the escape sequences and glyphs of one frame are appended
+ * into it and the whole frame is then sent to the terminal by a single write. The buffer is meant to be
+ * created once and reused for all the frames, so it does not allocate once it has grown to the frame size.
+ *
+ * @version 0.1
+ * @date 2023-09-20
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef FRAME_H
+#define FRAME_H
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * @struct frame_buffer_t
+ * @brief Data structure representing a growable byte buffer holding the output of one frame.
+ */
+typedef struct frame_buffer_t {
+    char *data;         /** Bytes of the frame. */
+    size_t length;      /** Number of bytes currently stored in the buffer. */
+    size_t capacity;    /** Allocated size of the buffer. */
+} frame_buffer_t;
+
+/**
+ * @brief Creates an empty frame buffer.
+ *
+ * @param capacity The initial capacity of the buffer in bytes.
+ * @return A pointer to the created frame buffer, or NULL on failure.
+ */
+frame_buffer_t *create_frame_buffer(size_t capacity);
+
+/**
+ * @brief Appends bytes at the end of the frame buffer. The buffer grows if needed.
+ *
+ * @param frame The frame buffer to append to.
+ * @param bytes The bytes to append.
+ * @param length The number of bytes to append.
+ * @return true on success, false if the buffer could not grow.
+ */
+bool append_to_frame_buffer(frame_buffer_t *frame, const char *bytes, size_t length);
+
+/**
+ * @brief Appends formatted text at the end of the frame buffer. The buffer grows if needed.
+ *
+ * @param frame The frame buffer to append to.
+ * @param format The format string for the text.
+ * @param args Arguments for formatting.
+ * @return true on success, false if the buffer could not grow.
+ */
+bool append_formatted_to_frame_buffer(frame_buffer_t *frame, const char *format, va_list args);
+
+/**
+ * @brief Sends the content of the frame buffer into the file descriptor and empties the buffer.
+ *        The content is written by a single `write()` unless the kernel accepts only part of it.
+ *
+ * @param frame The frame buffer to send.
+ * @param file_descriptor The file descriptor to write into.
+ * @return 0 on success, -1 on failure.
+ */
+int write_frame_buffer(frame_buffer_t *frame, int file_descriptor);
+
+/**
+ * @brief Empties the frame buffer while keeping its allocated memory.
+ *
+ * @param frame The frame buffer to empty.
+ */
+void clear_frame_buffer(frame_buffer_t *frame);
+
+/**
+ * @brief Releases memory allocated for a frame buffer.
+ *
+ * @param frame The frame buffer to release.
+ */
+void release_frame_buffer(frame_buffer_t *frame);
+
+#endif
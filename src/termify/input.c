@@ -0,0 +1,126 @@
+#include <errno.h>
+#include <sys/select.h>
+#include <unistd.h>
+
+#include "input.h"
+#include "log.h"
+
+// ---------------------------------- STATIC DECLARATIONS--------------------------------------- //
+
+static bool is_input_waiting(int file_descriptor);
+static char peek_byte(input_buffer_t *input, int offset);
+static int get_key_length(input_buffer_t *input);
+static void drop_bytes(input_buffer_t *input, int count);
+
+// ----------------------------------------- PROGRAM-------------------------------------------- //
+
+void init_input_buffer(input_buffer_t *input)
+{
+    input->head = 0;
+    input->count = 0;
+}
+
+int drain_input(input_buffer_t *input, int file_descriptor)
+{
+    int total = 0;
+
+    while (is_input_waiting(file_descriptor)) {
+        char bytes[INPUT_BUFFER_CAPACITY];
+        ssize_t length = read(file_descriptor, bytes, sizeof(bytes));
+        if (length == -1) {
+            if (errno == EINTR) {
+                continue;
+            }
+            resolve_error(GENERAL_IO_ERROR, "invalid operation with function \'read()\'.");
+            return -1;
+        }
+        if (length == 0) {
+            // the end of the input (e.g. the terminal was closed)
+            return -1;
+        }
+
+        for (ssize_t i = 0; i < length; ++i) {
+            if (input->count == INPUT_BUFFER_CAPACITY) {
+                // the whole oldest key is dropped, so an escape sequence is never cut in the middle
+                drop_bytes(input, get_key_length(input));
+            }
+            input->data[(input->head + input->count) % INPUT_BUFFER_CAPACITY] = bytes[i];
+            input->count++;
+        }
+        total += length;
+    }
+
+    return total;
+}
+
+int read_key(input_buffer_t *input)
+{
+    if (input->count == 0) {
+        return KEY_NONE;
+    }
+
+    int length = get_key_length(input);
+    int key = (length == 3) ? KEY_ARROW_UP + (peek_byte(input, 2) - 'A') : (unsigned char)peek_byte(input, 0);
+    drop_bytes(input, length);
+    return key;
+}
+
+/**
+ * @brief Checks whether there are bytes waiting in the file descriptor, without blocking.
+ *
+ * @param file_descriptor The file descriptor.
+ * @return true if a read would not block, false otherwise.
+ */
+static bool is_input_waiting(int file_descriptor)
+{
+    fd_set read_fds;
+    FD_ZERO(&read_fds);
+    FD_SET(file_descriptor, &read_fds);
+
+    struct timeval timeout;
+    timeout.tv_sec = 0; timeout.tv_usec = 0;
+
+    return select(file_descriptor + 1, &read_fds, NULL, NULL, &timeout) > 0;
+}
+
+/**
+ * @brief Gets a byte of the buffer without taking it out.
+ *
+ * @param input The buffer.
+ * @param offset The position of the byte counted from the oldest one (it must be lower than the number of bytes).
+ * @return The byte.
+ */
+static char peek_byte(input_buffer_t *input, int offset)
+{
+    return input->data[(input->head + offset) % INPUT_BUFFER_CAPACITY];
+}
+
+/**
+ * @brief Gets the number of bytes of the oldest key in the buffer. Arrow keys come as "ESC [ A" to "ESC [ D",
+ *        every other key is a single byte.
+ *
+ * @param input The buffer (it must not be empty).
+ * @return The number of bytes of the key.
+ */
+static int get_key_length(input_buffer_t *input)
+{
+    if (peek_byte(input, 0) == KEY_ESCAPE && input->count >= 3 && peek_byte(input, 1) == '[') {
+        char final_byte = peek_byte(input, 2);
+        if (final_byte >= 'A' && final_byte <= 'D') {
+            return 3;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Takes the oldest bytes out of the buffer.
+ *
+ * @param input The buffer.
+ * @param count The number of bytes to take out (it must not exceed the number of bytes).
+ */
+static void drop_bytes(input_buffer_t *input, int count)
+{
+    input->head = (input->head + count) % INPUT_BUFFER_CAPACITY;
+    input->count -= count;
+}
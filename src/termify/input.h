@@ -0,0 +1,67 @@
+/**
+ * @file input.h
+ * @author Marek Eibel
+ * @brief Header file containing the input ring buffer used for reading the keyboard inside loops.
+ *
+ * Every loop iteration drains all the bytes waiting in the terminal with `drain_input()`, so nothing piles up in
+ * the tty queue, and then parses them into keys with `read_key()`. Escape sequences of the arrow keys are parsed
+ * into single keys. If more bytes arrive than the buffer can hold, the oldest keys are dropped as a whole (so
+ * an arrow key is never cut into a lone ESC), because only the latest input matters for a running game.
+ *
+ * @version 0.1
+ * @date 2023-09-27
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef INPUT_H
+#define INPUT_H
+
+#include <stdbool.h>
+
+#define INPUT_BUFFER_CAPACITY 64
+
+#define KEY_NONE -1
+#define KEY_ESCAPE 27
+#define KEY_ARROW_UP 256
+#define KEY_ARROW_DOWN 257
+#define KEY_ARROW_RIGHT 258
+#define KEY_ARROW_LEFT 259
+
+/**
+ * @struct input_buffer_t
+ * @brief Data structure representing a ring buffer of bytes read from the terminal.
+ */
+typedef struct input_buffer_t {
+    char data[INPUT_BUFFER_CAPACITY];   /** Bytes of the buffer. */
+    int head;                           /** Index of the oldest byte. */
+    int count;                          /** Number of bytes stored in the buffer. */
+} input_buffer_t;
+
+/**
+ * @brief Initializes an empty input buffer.
+ *
+ * @param input The buffer to initialize.
+ */
+void init_input_buffer(input_buffer_t *input);
+
+/**
+ * @brief Reads all the bytes which are waiting in the file descriptor into the buffer. The function never blocks.
+ *
+ * @param input The buffer.
+ * @param file_descriptor The file descriptor to read from.
+ * @return The number of bytes read, or -1 on failure or at the end of the input.
+ */
+int drain_input(input_buffer_t *input, int file_descriptor);
+
+/**
+ * @brief Takes the next key out of the buffer. Arrow keys are returned as KEY_ARROW_* values,
+ *        all the other bytes as they are.
+ *
+ * @param input The buffer.
+ * @return The key, or KEY_NONE if the buffer is empty.
+ */
+int read_key(input_buffer_t *input);
+
+#endif
@@ -1,3 +1,5 @@
+#include <pthread.h>
+#include <stdatomic.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <stdbool.h>
@@ -12,13 +14,19 @@
 /**
  * @brief Variable holds the current log level in use. This variable can be set only by set_log_level().
  */
-static log_levels_t gl_curr_log_level = LOG_LOG;
+static _Atomic log_levels_t gl_curr_log_level = LOG_LOG;
 
 /**
  * @brief Boolean variable holds the state if the logs.log file was opened at least once in the course of program.
  */
 static bool gl_has_been_log_file_already_opened = false;
 
+/**
+ * @brief Mutex serializing the writes into the log files, so lines logged by different threads (e.g. the workers of
+ * a batch simulation) are never mixed. It also guards `gl_has_been_log_file_already_opened`.
+ */
+static pthread_mutex_t gl_log_file_mutex = PTHREAD_MUTEX_INITIALIZER;
+
 // ---------------------------------- STATIC DECLARATIONS--------------------------------------- //
 
 static bool check_log_level(log_levels_t level);
@@ -28,6 +36,7 @@ static const char *get_log_levels_string(log_levels_t level);
 static const char *get_log_level_type_string(log_levels_t level, log_level_type_t log_level_type);
 static const char *get_error_string(errors_t error);
 static const char* create_log_line(log_levels_t level, log_level_type_t inner_log_level_type);
+static FILE *open_log_file(const char *file_path);
 
 // ----------------------------------------- PROGRAM-------------------------------------------- //
 
@@ -75,10 +84,10 @@ static const char *create_data_and_time_stamp_string()
 {
     const int BUFFER_SIZE = 20;
     time_t current_time;
-    struct tm *local_time;
+    struct tm local_time;
 
     time(&current_time);
-    local_time = localtime(&current_time);
+    localtime_r(&current_time, &local_time);
 
     char *date_and_time_stamp = malloc(BUFFER_SIZE * sizeof(char));
 
@@ -87,7 +96,7 @@ static const char *create_data_and_time_stamp_string()
         return NULL;
     }
 
-    strftime(date_and_time_stamp, BUFFER_SIZE, "%Y-%m-%d %H:%M:%S", local_time);
+    strftime(date_and_time_stamp, BUFFER_SIZE, "%Y-%m-%d %H:%M:%S", &local_time);
 
     return (const char *)date_and_time_stamp;
 }
@@ -101,9 +110,9 @@ static const char *create_data_and_time_stamp_string()
  */
 static const char *create_user_name_string()
 {
+    // no error is logged here, the function is called while logging and the caller uses "unknown_user" instead
     char *user_name = getenv("USER");
     if (user_name == NULL) {
-        resolve_error(GENERAL_ERROR, "could not get USER variable from the environment variables.");
         return NULL;
     }
 
@@ -194,21 +203,6 @@ void termify_log(log_levels_t level, const char *file_path, log_level_type_t typ
         return;
     }
 
-    if (!gl_has_been_log_file_already_opened && access(file_path, F_OK) == 0) {
-        if (remove(file_path) != 0) {
-            fprintf(stderr, "Critical error occured: unable to remove file \"%s\" before logging of the error message!\n", file_path);
-            return;
-        }
-    }
-
-    gl_has_been_log_file_already_opened = true;
-
-    FILE *file = fopen(file_path, "a");
-    if (file == NULL) {
-        fprintf(stderr, "Critical error occured: unable to write into the \"%s\" file while logging the error message!\n", file_path);
-        return;
-    }
-
     const char *UNKNOWN_DATE_AND_TIME = "???\?-?\?-?? ??:??:??";
 
     const char *date_and_time_stamp = create_data_and_time_stamp_string();
@@ -225,8 +219,14 @@ void termify_log(log_levels_t level, const char *file_path, log_level_type_t typ
     const char *log_level_type_string = get_log_level_type_string(level, type_of_message_in_the_given_level);
     const char *message = (additional_string == NULL) ? "" : additional_string;
 
-    fprintf(file, "%s (%s)\t\t[%s]%s%s\n", date_and_time_stamp, user_name, log_levels_string, log_level_type_string, message);
-    fclose(file);
+    // the strings above may log errors themselves, so they are created before the file is locked
+    pthread_mutex_lock(&gl_log_file_mutex);
+    FILE *file = open_log_file(file_path);
+    if (file != NULL) {
+        fprintf(file, "%s (%s)\t\t[%s]%s%s\n", date_and_time_stamp, user_name, log_levels_string, log_level_type_string, message);
+        fclose(file);
+    }
+    pthread_mutex_unlock(&gl_log_file_mutex);
     
     if (!STR_EQ(date_and_time_stamp, UNKNOWN_DATE_AND_TIME)) {
         free((char*)date_and_time_stamp);
@@ -254,11 +254,29 @@ void log_error(const char *file_path, errors_t error, const char *additional_str
 }
 
 void log_stack_trace_node(const char *file_path, const char *source_file_name, const char *function, int line)
+{
+    pthread_mutex_lock(&gl_log_file_mutex);
+    FILE *file = open_log_file(file_path);
+    if (file != NULL) {
+        fprintf(file, "\t├── %s:%d in function \'%s\'\n", source_file_name, line, function);
+        fclose(file);
+    }
+    pthread_mutex_unlock(&gl_log_file_mutex);
+}
+
+/**
+ * @brief Opens the log file for appending. The file left by the previous run of the program is removed
+ *        the first time. The caller has to hold `gl_log_file_mutex`.
+ *
+ * @param file_path File path of the log file.
+ * @return The opened file, or NULL on failure (reported to the standard error output).
+ */
+static FILE *open_log_file(const char *file_path)
 {
     if (!gl_has_been_log_file_already_opened && access(file_path, F_OK) == 0) {
         if (remove(file_path) != 0) {
             fprintf(stderr, "Critical error occured: unable to remove file \"%s\" before logging of the error message!\n", file_path);
-            return;
+            return NULL;
         }
     }
 
@@ -267,9 +285,8 @@ void log_stack_trace_node(const char *file_path, const char *source_file_name, c
     FILE *file = fopen(file_path, "a");
     if (file == NULL) {
         fprintf(stderr, "Critical error occured: unable to write into the \"%s\" file while logging the error message!\n", file_path);
-        return;
+        return NULL;
     }
 
-    fprintf(file, "\t├── %s:%d in function \'%s\'\n", source_file_name, line, function);   
-    fclose(file);
+    return file;
 }
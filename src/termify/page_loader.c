@@ -16,6 +16,14 @@
 #include "terminal.h"
 #include "utils.h"
 
+// ---------------------------------------- MACROS --------------------------------------------- //
+
+#define FRAME_BUFFER_BEGIN_CAPACITY 16384
+
+// ---------------------------------- STATIC DECLARATIONS--------------------------------------- //
+
+static page_return_code_t load_page_content(page_t page, px_t height, px_t width, page_loader_inner_data_t *data, terminal_data_t *terminal_data);
+
 // ----------------------------------------- PROGRAM-------------------------------------------- //
 
 page_t find_page(page_t current_page, const char *command, page_loader_inner_data_t *data)
@@ -25,33 +33,18 @@ page_t find_page(page_t current_page, const char *command, page_loader_inner_dat
 
 page_return_code_t load_page(page_t page, px_t height, px_t width, page_loader_inner_data_t *data, terminal_data_t *terminal_data)
 {
-    switch (page)
-    {
-    case MAIN_PAGE:
-        return load_main_page(height, width, data, terminal_data);
-    case ABOUT_PAGE:
-        return load_about_page(height, width, data, terminal_data);
-    case QUIT_WITHOUT_CONFIRMATION_PAGE:
-        return ERROR;
-    case GAME_PAGE:
+    // the game loop sends its own frames
+    if (page == GAME_PAGE) {
         return load_game(height, GAME_WIDTH, data);
-    case AFTER_GAME_PAGE:
-        return load_after_game_page(height, width, data, terminal_data);
-    case PRE_CREATE_NEW_PLAYER_PAGE:
-        return load_pre_create_new_player_page(height, width, data, terminal_data);
-    case CHOOSE_PLAYER_PAGE:
-        return load_choose_player_page(height, width, data, terminal_data);
-    case ERROR_PAGE:
-        return load_error_page(height, width);
-    case CREATE_NEW_PLAYER_PAGE:
-        return load_create_new_player_page(height, width, data, terminal_data);
-    case BACK_WITH_CONFIRMATION_FROM_CREATE_NEW_PLAYER_PAGE_PAGE:
-        return load_quit_or_back_with_confirmation(height, width, data, terminal_data);
-    case QUIT_WITH_CONFIRMATION_FROM_CREATE_NEW_PLAYER_PAGE_PAGE:
-        return load_quit_or_back_with_confirmation(height, width, data, terminal_data);
-    default:
-        return load_not_found_page(height, width);
     }
+
+    begin_frame(data->frame);
+    page_return_code_t return_code = load_page_content(page, height, width, data, terminal_data);
+    if (end_frame() == -1) {
+        return ERROR;
+    }
+
+    return return_code;
 }
 
 const char *convert_page_2_string(page_t page)
@@ -78,7 +71,7 @@ const char *convert_page_2_string(page_t page)
     }
 }
 
-page_loader_inner_data_t *create_page_loader_inner_data()
+page_loader_inner_data_t *create_page_loader_inner_data(event_loop_t *event_loop)
 {
     page_loader_inner_data_t *data = malloc(sizeof(page_loader_inner_data_t));
     if (data == NULL) {
@@ -88,6 +81,14 @@ page_loader_inner_data_t *create_page_loader_inner_data()
 
     data->curr_player_name_seen_flag = false; data->curr_players_page_index = 0; data->players_count = 0;
     data->terminal_signal = false; data->curr_player_name = NULL; data->player_choosen_to_game = NULL;
+    data->event_loop = event_loop;
+    data->step_duration = DEFAULT_GAME_STEP_DURATION; data->frame_period = DEFAULT_GAME_FRAME_PERIOD;
+
+    data->frame = create_frame_buffer(FRAME_BUFFER_BEGIN_CAPACITY);
+    if (data->frame == NULL) {
+        free(data);
+        return NULL;
+    }
 
     return data;
 }
@@ -95,6 +96,46 @@ page_loader_inner_data_t *create_page_loader_inner_data()
 void release_page_loader_inner_data(page_loader_inner_data_t *data)
 {
     if (data != NULL) {
+        release_frame_buffer(data->frame);
         free(data);
     }
 }
+
+/**
+ * @brief Draws the content of a specific page based on the page enum.
+ *
+ * @param page The page to load.
+ * @param height The height of the terminal window.
+ * @param width The width of the terminal window.
+ * @param data Page loader inner data structure.
+ * @param terminal_data Terminal data structure for rendering.
+ * @return The return code indicating success or error.
+ */
+static page_return_code_t load_page_content(page_t page, px_t height, px_t width, page_loader_inner_data_t *data, terminal_data_t *terminal_data)
+{
+    switch (page)
+    {
+    case MAIN_PAGE:
+        return load_main_page(height, width, data, terminal_data);
+    case ABOUT_PAGE:
+        return load_about_page(height, width, data, terminal_data);
+    case QUIT_WITHOUT_CONFIRMATION_PAGE:
+        return ERROR;
+    case AFTER_GAME_PAGE:
+        return load_after_game_page(height, width, data, terminal_data);
+    case PRE_CREATE_NEW_PLAYER_PAGE:
+        return load_pre_create_new_player_page(height, width, data, terminal_data);
+    case CHOOSE_PLAYER_PAGE:
+        return load_choose_player_page(height, width, data, terminal_data);
+    case ERROR_PAGE:
+        return load_error_page(height, width);
+    case CREATE_NEW_PLAYER_PAGE:
+        return load_create_new_player_page(height, width, data, terminal_data);
+    case BACK_WITH_CONFIRMATION_FROM_CREATE_NEW_PLAYER_PAGE_PAGE:
+        return load_quit_or_back_with_confirmation(height, width, data, terminal_data);
+    case QUIT_WITH_CONFIRMATION_FROM_CREATE_NEW_PLAYER_PAGE_PAGE:
+        return load_quit_or_back_with_confirmation(height, width, data, terminal_data);
+    default:
+        return load_not_found_page(height, width);
+    }
+}
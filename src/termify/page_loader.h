@@ -12,6 +12,8 @@
 #define PAGE_LOADER_H
 
 #include "draw.h"
+#include "event_loop.h"
+#include "frame.h"
 #include "../interstellar-pong-implementation/player.h"
 #include "terminal.h"
 
@@ -68,6 +70,10 @@ typedef struct page_loader_inner_data_t {
     bool curr_player_name_seen_flag;     /** Flag indicating if the current player's name has been seen. */
     player_t *player_choosen_to_game;    /** Chosen player for the game. */
     bool terminal_signal;                /** Terminal signal status. */
+    frame_buffer_t *frame;               /** Frame buffer reused for the output of all pages. */
+    event_loop_t *event_loop;            /** Event loop of the application, pages which run on their own (the game) register their handlers on it. */
+    nanoseconds_t step_duration;         /** Duration of one simulation step of the games (see `set_game_step_duration()`). */
+    nanoseconds_t frame_period;          /** Period of the frames rendered by the games, independent of the simulation steps. */
 } page_loader_inner_data_t;
 
 /**
@@ -96,12 +102,13 @@ page_t find_page(page_t current_page, const char *command, page_loader_inner_dat
  * @brief Creates a new page_loader_inner_data_t structure.
  * 
  * This function dynamically allocates memory for a page_loader_inner_data_t structure
- * and initializes its fields to default values.
+ * and initializes its fields to default values. The games run at DEFAULT_GAME_STEP_DURATION and DEFAULT_GAME_FRAME_PERIOD.
  * 
+ * @param event_loop The event loop of the application.
  * @return A pointer to the newly allocated page_loader_inner_data_t structure.
  * @retval NULL if memory allocation fails.
  */
-page_loader_inner_data_t *create_page_loader_inner_data();
+page_loader_inner_data_t *create_page_loader_inner_data(event_loop_t *event_loop);
 
 /**
  * @brief Releases the memory used by a page_loader_inner_data_t structure.
@@ -0,0 +1,94 @@
+#include <unistd.h>
+
+#include "clock.h"
+#include "random.h"
+
+// ---------------------------------------- MACROS --------------------------------------------- //
+
+#define PCG_MULTIPLIER 6364136223846793005ULL
+
+// ---------------------------------- STATIC DECLARATIONS--------------------------------------- //
+
+static uint64_t mix_seed(uint64_t *seed);
+
+// ----------------------------------------- PROGRAM-------------------------------------------- //
+
+uint64_t create_random_seed(void)
+{
+    uint64_t seed = (uint64_t)get_monotonic_time() ^ ((uint64_t)getpid() << 32);
+    return mix_seed(&seed);
+}
+
+void seed_random(random_t *random, uint64_t seed)
+{
+    // close seeds (e.g. seeds of consecutive games) have to give unrelated streams, so the seed is mixed first
+    uint64_t mixed_seed = seed;
+    random->state = 0;
+    random->increment = (mix_seed(&mixed_seed) << 1) | 1;
+    (void)next_random(random);
+    random->state += mix_seed(&mixed_seed);
+    (void)next_random(random);
+}
+
+uint32_t next_random(random_t *random)
+{
+    uint64_t old_state = random->state;
+    random->state = old_state * PCG_MULTIPLIER + random->increment;
+
+    // XSH RR output function: xorshift of the high bits and a rotation chosen by the top five bits
+    uint32_t xorshifted = (uint32_t)(((old_state >> 18) ^ old_state) >> 27);
+    uint32_t rotation = (uint32_t)(old_state >> 59);
+    return (xorshifted >> rotation) | (xorshifted << ((32 - rotation) & 31));
+}
+
+int random_below(random_t *random, int bound)
+{
+    // multiply-shift maps the number into [0, bound), the numbers in the uneven low part are rejected (Lemire)
+    uint32_t range = (uint32_t)bound;
+    uint64_t product = (uint64_t)next_random(random) * range;
+    uint32_t low = (uint32_t)product;
+
+    if (low < range) {
+        uint32_t threshold = -range % range;
+        while (low < threshold) {
+            product = (uint64_t)next_random(random) * range;
+            low = (uint32_t)product;
+        }
+    }
+
+    return (int)(product >> 32);
+}
+
+void build_percent_table(percent_table_t *table, const int *probabilities, int count)
+{
+    int outcome = 0;
+    int cumulative = (count > 0) ? probabilities[0] : 0;
+
+    // an outcome too low for a draw is too low for all the higher draws, so the outcomes are found in one pass
+    for (int draw = 0; draw < PERCENT_TABLE_SIZE; ++draw) {
+        while (outcome < count && draw + 1 > cumulative) {
+            outcome++;
+            cumulative += (outcome < count) ? probabilities[outcome] : 0;
+        }
+        table->outcomes[draw] = (outcome < count) ? (int8_t)outcome : -1;
+    }
+}
+
+int sample_percent_table(const percent_table_t *table, random_t *random)
+{
+    return table->outcomes[random_below(random, PERCENT_TABLE_SIZE)];
+}
+
+/**
+ * @brief Advances the seed and returns its next well-mixed value (SplitMix64).
+ *
+ * @param seed The seed to advance.
+ * @return The mixed value.
+ */
+static uint64_t mix_seed(uint64_t *seed)
+{
+    uint64_t value = (*seed += 0x9E3779B97F4A7C15ULL);
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+    return value ^ (value >> 31);
+}
@@ -0,0 +1,99 @@
+/**
+ * @file random.h
+ * @author Marek Eibel
+ * @brief Header file containing a small and fast pseudo-random number generator (PCG32).
+ *
+ * Unlike `rand()`, the whole state of the generator lives in a `random_t` owned by the caller, so every game
+ * can have its own generator: games seeded the same way produce the same numbers, and games running on
+ * different threads never share (or lock) any state. Bounded numbers are computed without the modulo bias
+ * of `rand() % bound`.
+ *
+ * Discrete distributions given in whole percent are sampled through percent tables: the outcome of every possible
+ * draw is precomputed once, so sampling costs one bounded number and one array access.
+ *
+ * @version 0.1
+ * @date 2023-10-03
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <stdint.h>
+
+/**
+ * @brief Number of the entries of a percent table (the probabilities of its outcomes are given in whole percent).
+ */
+#define PERCENT_TABLE_SIZE 100
+
+/**
+ * @struct random_t
+ * @brief Data structure representing the state of a PCG32 generator.
+ */
+typedef struct random_t {
+    uint64_t state;        /** Internal state of the generator. */
+    uint64_t increment;    /** Increment selecting the stream of the generator (always odd). */
+} random_t;
+
+/**
+ * @struct percent_table_t
+ * @brief Data structure representing a discrete distribution given in whole percent, precomputed for sampling.
+ */
+typedef struct percent_table_t {
+    int8_t outcomes[PERCENT_TABLE_SIZE];   /** Outcome of every draw from [0, PERCENT_TABLE_SIZE), -1 for draws not covered by the probabilities. */
+} percent_table_t;
+
+/**
+ * @brief Creates a seed from the current time and the process ID, for generators which do not have to be repeatable.
+ *
+ * @return The seed.
+ */
+uint64_t create_random_seed(void);
+
+/**
+ * @brief Seeds the generator. Generators with the same seed produce the same numbers.
+ *
+ * @param random The generator.
+ * @param seed The seed.
+ */
+void seed_random(random_t *random, uint64_t seed);
+
+/**
+ * @brief Gets the next 32-bit number of the generator.
+ *
+ * @param random The generator.
+ * @return The number.
+ */
+uint32_t next_random(random_t *random);
+
+/**
+ * @brief Gets the next number of the generator in [0, bound), all the values with the same probability.
+ *
+ * @param random The generator.
+ * @param bound The upper bound (excluded), it has to be positive.
+ * @return The number.
+ */
+int random_below(random_t *random, int bound);
+
+/**
+ * @brief Precomputes the outcome of every draw of the distribution. A draw `d` gives the first outcome whose cumulative
+ *        probability is at least `d + 1`, so probabilities summing to less than 100 leave the last draws uncovered.
+ *
+ * @param table The table to fill.
+ * @param probabilities The probabilities of the outcomes in percent.
+ * @param count The number of the outcomes (at most INT8_MAX).
+ */
+void build_percent_table(percent_table_t *table, const int *probabilities, int count);
+
+/**
+ * @brief Draws an outcome of the distribution.
+ *
+ * @param table The table of the distribution.
+ * @param random The generator.
+ * @return The index of the outcome, or -1 if the draw is not covered by the probabilities.
+ */
+int sample_percent_table(const percent_table_t *table, random_t *random);
+
+#endif
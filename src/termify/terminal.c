@@ -1,9 +1,11 @@
+#include <limits.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
 
+#include "input.h"
 #include "log.h"
 #include "terminal.h"
 #include "utils.h"
@@ -13,7 +15,6 @@
 #define TERMINAL_FILE_PATH "src/termify/temp/user_input.data"
 #define TERMINAL_LINE_LENGTH_HARD_LIMIT 512
 #define BACKSPACE 127
-#define ESCPAPE 27
 #define NEWLINE '\n'
 
 // ---------------------------------- STATIC DECLARATIONS--------------------------------------- //
@@ -30,7 +31,7 @@ static int get_maximal_terminal_buffer_size(unsigned long current_line_size);
 static void restore_terminal_attributes(struct termios *original_termios);
 static int parse_newline(terminal_data_t *terminal_data, char **command);
 static int parse_backspace(terminal_data_t *terminal_data, FILE *file);
-static int handle_arrow_up_and_down(terminal_data_t *terminal_data);
+static int handle_arrow_up_and_down(terminal_data_t *terminal_data, int key);
 static struct termios init_termios();
 static bool check_character(char c);
 
@@ -110,16 +111,18 @@ int close_terminal(terminal_data_t *terminal_data)
     return 0;
 }
 
-int process_command(terminal_data_t *terminal_data, char c, char **command)
+int process_command(terminal_data_t *terminal_data, int key, char **command)
 {
-    if (!check_character(c)) {
-        return 0;
+    if (key == KEY_ARROW_UP || key == KEY_ARROW_DOWN) {
+        return handle_arrow_up_and_down(terminal_data, key);
     }
 
-    if (c == ESCPAPE) {
-        return handle_arrow_up_and_down(terminal_data);
+    if (key < 0 || key > CHAR_MAX || !check_character((char)key)) {
+        return 0;
     }
 
+    char c = (char)key;
+
     if (!terminal_data->is_terminal_enabled) {
         resolve_error(INACTIVE_TERMINAL, NULL);
         return -1;
@@ -259,17 +262,17 @@ int render_terminal(terminal_data_t *terminal_data, px_t line_width, bool specia
     switch (mode_to_print_with)
     {
     case TERMINAL_NORMAL_TEXT:
-        printf("%s", string_to_print); break;
+        write_raw_text("%s", string_to_print); break;
     case TERMINAL_LOG:
-        printf("\033[3m\033[90m%s\033[0m", string_to_print); break;
+        write_raw_text("\033[3m\033[90m%s\033[0m", string_to_print); break;
     case TERMINAL_APPROVAL:
-        printf("\033[0;32m%s\033[0m", string_to_print); break;
+        write_raw_text("\033[0;32m%s\033[0m", string_to_print); break;
     case TERMINAL_WARNING:
-        printf("\033[0;33m%s\033[0m", string_to_print); break;
+        write_raw_text("\033[0;33m%s\033[0m", string_to_print); break;
     case TERMINAL_ERROR:
-        printf("\033[0;31m%s\033[0m", string_to_print); break;
+        write_raw_text("\033[0;31m%s\033[0m", string_to_print); break;
     case TERMINAL_N_A:
-        printf("%s", string_to_print); break;
+        write_raw_text("%s", string_to_print); break;
     default:
         break;
     }
@@ -309,17 +312,15 @@ static int clear_terminal_window(terminal_data_t *terminal_data, FILE *file)
  * The effect of pressing these buttons is definied as browsing the commands history.
  *
  * @param terminal_data A pointer to the terminal_data_t structure.
+ * @param key The pressed key (KEY_ARROW_UP or KEY_ARROW_DOWN).
  *
  * @return 0 on success, -1 on failure
  */
-static int handle_arrow_up_and_down(terminal_data_t *terminal_data)
+static int handle_arrow_up_and_down(terminal_data_t *terminal_data, int key)
 {
-    int c1 = getchar();
-    int c2 = getchar();
-
-    if (c1 == '[' && c2 == 'A') {
+    if (key == KEY_ARROW_UP) {
         terminal_data->curr_line--;
-    } else if (c1 == '[' && c2 == 'B') {
+    } else if (key == KEY_ARROW_DOWN) {
         terminal_data->curr_line++;
     } else {
         return 0;
@@ -465,7 +466,7 @@ static void release_terminal_file_cursor_storage(terminal_file_cursor_storage_t
  */
 static bool check_character(char c)
 {
-    if (c == BACKSPACE || c == NEWLINE || (c >= 32 && c <= 126) || c == ESCPAPE) {
+    if (c == BACKSPACE || c == NEWLINE || (c >= 32 && c <= 126)) {
         return true;
     }
 
@@ -117,14 +117,15 @@ int render_terminal(terminal_data_t *terminal_data, px_t line_width, bool specia
 /**
  * @brief Process a keyboard input character for the terminal.
  *
- * The `process_command` function processes a keyboard input character for the terminal, including handling
+ * The `process_command` function processes a keyboard input key for the terminal, including handling
  * backspace and newline characters. It writes the character to the terminal file and manages cursor position.
+ * Arrow up and arrow down browse the history of the commands.
  *
  * @param terminal_data A pointer to the terminal data structure.
- * @param c The input character to be processed.
+ * @param key The key to be processed (a character or one of the KEY_ARROW_* values from input.h).
  * @param command A pointer to the command string that will be set if a newline character is detected.
  * @return 0 on success, -1 on failure.
  */
-int process_command(terminal_data_t *terminal_data, char c, char **command); 
+int process_command(terminal_data_t *terminal_data, int key, char **command); 
 
 #endif
\ No newline at end of file
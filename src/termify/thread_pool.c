@@ -0,0 +1,228 @@
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "log.h"
+#include "thread_pool.h"
+
+/**
+ * @struct parallel_for_t
+ * @brief Data structure representing one run of `run_parallel_for()` shared by its workers.
+ */
+typedef struct parallel_for_t {
+    work_range_t *ranges;     /** Ranges of the workers. */
+    int workers_count;        /** Number of the workers. */
+    parallel_task_t task;     /** Function to run. */
+    void *context;            /** Pointer passed to the function. */
+} parallel_for_t;
+
+/**
+ * @struct worker_t
+ * @brief Data structure representing the argument of a worker thread.
+ */
+typedef struct worker_t {
+    parallel_for_t *parallel_for;    /** The shared run. */
+    int index;                       /** Index of the worker. */
+} worker_t;
+
+// ---------------------------------- STATIC DECLARATIONS--------------------------------------- //
+
+static void *run_worker(void *argument);
+static bool take_index(work_range_t *range, int *index);
+static bool steal_range(parallel_for_t *parallel_for, int thief);
+static int get_range_length(work_range_t *range);
+
+// ----------------------------------------- PROGRAM-------------------------------------------- //
+
+int get_available_cores(void)
+{
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    return (cores < 1) ? 1 : (int)cores;
+}
+
+bool run_parallel_for(int count, int workers_count, parallel_task_t task, void *context)
+{
+    if (count <= 0) {
+        return true;
+    }
+
+    if (workers_count > MAX_WORKERS) {
+        workers_count = MAX_WORKERS;
+    }
+    if (workers_count > count) {
+        workers_count = count;
+    }
+    if (workers_count < 1) {
+        workers_count = 1;
+    }
+
+    // aligned_alloc() needs the size to be a multiple of the alignment, which the padded ranges are
+    work_range_t *ranges = aligned_alloc(CACHE_LINE_SIZE, workers_count * sizeof(work_range_t));
+    worker_t *workers = malloc(workers_count * sizeof(worker_t));
+    pthread_t *threads = malloc(workers_count * sizeof(pthread_t));
+    bool *is_thread_running = calloc(workers_count, sizeof(bool));
+    if (ranges == NULL || workers == NULL || threads == NULL || is_thread_running == NULL) {
+        resolve_error(MEM_ALOC_FAILURE, NULL);
+        free(ranges);
+        free(workers);
+        free(threads);
+        free(is_thread_running);
+        return false;
+    }
+
+    parallel_for_t parallel_for = { ranges, workers_count, task, context };
+
+    // equal contiguous ranges, the first (count % workers_count) workers get one index more
+    int begin = 0;
+    for (int i = 0; i < workers_count; ++i) {
+        int length = count / workers_count + ((i < count % workers_count) ? 1 : 0);
+        pthread_mutex_init(&ranges[i].mutex, NULL);
+        ranges[i].begin = begin;
+        ranges[i].end = begin + length;
+        begin += length;
+
+        workers[i].parallel_for = &parallel_for;
+        workers[i].index = i;
+    }
+
+    // the calling thread is the worker 0, a thread which cannot be created leaves its range to the thieves
+    for (int i = 1; i < workers_count; ++i) {
+        if (pthread_create(&threads[i], NULL, run_worker, &workers[i]) != 0) {
+            resolve_error(GENERAL_ERROR, "unable to create a thread of the thread pool.");
+            continue;
+        }
+        is_thread_running[i] = true;
+    }
+
+    (void)run_worker(&workers[0]);
+
+    for (int i = 1; i < workers_count; ++i) {
+        if (is_thread_running[i]) {
+            pthread_join(threads[i], NULL);
+        }
+    }
+
+    for (int i = 0; i < workers_count; ++i) {
+        pthread_mutex_destroy(&ranges[i].mutex);
+    }
+
+    free(ranges);
+    free(workers);
+    free(threads);
+    free(is_thread_running);
+
+    return true;
+}
+
+/**
+ * @brief Runs the tasks of the own range and then of the stolen ones until there is nothing left to steal.
+ *
+ * @param argument The worker_t of the worker.
+ * @return NULL.
+ */
+static void *run_worker(void *argument)
+{
+    worker_t *worker = (worker_t *)argument;
+    parallel_for_t *parallel_for = worker->parallel_for;
+    work_range_t *range = &parallel_for->ranges[worker->index];
+
+    int index;
+    do {
+        while (take_index(range, &index)) {
+            parallel_for->task(index, worker->index, parallel_for->context);
+        }
+    } while (steal_range(parallel_for, worker->index));
+
+    return NULL;
+}
+
+/**
+ * @brief Takes the first index of a range.
+ *
+ * @param range The range.
+ * @param index Placeholder for the taken index.
+ * @return true if an index was taken, false if the range is empty.
+ */
+static bool take_index(work_range_t *range, int *index)
+{
+    pthread_mutex_lock(&range->mutex);
+
+    bool is_taken = range->begin < range->end;
+    if (is_taken) {
+        *index = range->begin++;
+    }
+
+    pthread_mutex_unlock(&range->mutex);
+    return is_taken;
+}
+
+/**
+ * @brief Moves the upper half of the largest range of the other workers into the (empty) range of the thief.
+ *
+ * A victim which is just stealing itself may look empty, its work is never lost though, only run by the victim.
+ *
+ * @param parallel_for The shared run.
+ * @param thief The index of the stealing worker.
+ * @return true if something was stolen, false if all the other ranges are empty.
+ */
+static bool steal_range(parallel_for_t *parallel_for, int thief)
+{
+    while (true) {
+        // the sizes can change right after they are read, they only guide the choice of the victim
+        int victim = -1;
+        int largest_length = 0;
+        for (int i = 0; i < parallel_for->workers_count; ++i) {
+            if (i == thief) {
+                continue;
+            }
+            int length = get_range_length(&parallel_for->ranges[i]);
+            if (length > largest_length) {
+                victim = i;
+                largest_length = length;
+            }
+        }
+
+        if (victim == -1) {
+            return false;
+        }
+
+        work_range_t *range = &parallel_for->ranges[victim];
+        pthread_mutex_lock(&range->mutex);
+
+        int length = range->end - range->begin;
+        int stolen_begin = range->end - (length + 1) / 2;
+        int stolen_end = range->end;
+        if (length > 0) {
+            range->end = stolen_begin;
+        }
+
+        pthread_mutex_unlock(&range->mutex);
+
+        // the victim has finished its range in the meantime, choose again
+        if (length <= 0) {
+            continue;
+        }
+
+        work_range_t *own_range = &parallel_for->ranges[thief];
+        pthread_mutex_lock(&own_range->mutex);
+        own_range->begin = stolen_begin;
+        own_range->end = stolen_end;
+        pthread_mutex_unlock(&own_range->mutex);
+
+        return true;
+    }
+}
+
+/**
+ * @brief Gets the number of indices left in a range.
+ *
+ * @param range The range.
+ * @return The number of indices.
+ */
+static int get_range_length(work_range_t *range)
+{
+    pthread_mutex_lock(&range->mutex);
+    int length = range->end - range->begin;
+    pthread_mutex_unlock(&range->mutex);
+
+    return length;
+}
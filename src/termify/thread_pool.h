@@ -0,0 +1,66 @@
+/**
+ * @file thread_pool.h
+ * @author Marek Eibel
+ * @brief Header file containing a work-stealing pool of threads running independent tasks.
+ *
+ * `run_parallel_for()` runs a task for every index in [0, count). Every worker starts with an equal contiguous range
+ * of indices and takes them one by one from its front. A worker whose range is empty steals the upper half of
+ * the largest remaining range of another worker, so uneven tasks (e.g. games of different lengths) keep all
+ * the cores busy until the very end. Every range is guarded by its own mutex, which is locked only by its owner
+ * and by occasional thieves, and the ranges are padded to separate cache lines, so the workers do not contend.
+ *
+ * Tasks get the index of the worker running them, so they can accumulate their results into per-worker slots
+ * and merge them once the pool has finished, without any locking.
+ *
+ * @version 0.1
+ * @date 2023-10-02
+ *
+ * @copyright Copyright (c) 2023
+ *
+ */
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <pthread.h>
+#include <stdbool.h>
+
+#define CACHE_LINE_SIZE 64
+#define MAX_WORKERS 256
+
+/**
+ * @typedef parallel_task_t
+ * @brief Function called for every index of a parallel for. The worker is in [0, workers_count).
+ */
+typedef void (*parallel_task_t)(int index, int worker, void *context);
+
+/**
+ * @struct work_range_t
+ * @brief Data structure representing the indices a worker has not run yet. Each range takes its own cache line.
+ */
+typedef struct work_range_t {
+    _Alignas(CACHE_LINE_SIZE) pthread_mutex_t mutex;    /** Guards the range against thieves. */
+    int begin;                                          /** First index not run yet. */
+    int end;                                            /** Index after the last one. */
+} work_range_t;
+
+/**
+ * @brief Gets the number of the online processor cores.
+ *
+ * @return The number of the cores (at least 1).
+ */
+int get_available_cores(void);
+
+/**
+ * @brief Runs the task for every index in [0, count) on the given number of threads (the calling thread
+ *        is one of them) and waits until all of them are done.
+ *
+ * @param count The number of indices.
+ * @param workers_count The number of threads, it is clamped to [1, MAX_WORKERS] and to the count.
+ * @param task The function to run.
+ * @param context The pointer passed to the task.
+ * @return true on success, false on failure (no task has run then).
+ */
+bool run_parallel_for(int count, int workers_count, parallel_task_t task, void *context);
+
+#endif